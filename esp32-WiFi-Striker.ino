@@ -3,6 +3,11 @@
 #include "src/input/input_handler.h"
 #include "src/modules/wifi_scanner.h"
 #include "src/modules/attack_modes.h"
+#include "src/modules/survey_history.h"
+#include "src/input/serial_commands.h"
+#include "src/modules/heap_monitor.h"
+#include "src/modules/status_server.h"
+#include "src/modules/settings.h"
 
 void setup() {
   Serial.begin(115200);
@@ -16,12 +21,17 @@ void setup() {
   pinMode(joyY, INPUT);
   pinMode(joyBtn, INPUT_PULLUP);
   
-  // Initialize Wi-Fi
-  WiFi.mode(WIFI_STA);
-  WiFi.disconnect();
-  delay(100);
+  // Wi-Fi and the survey log start on first use to keep boot short
   
-  showMainMenu();
+  // Watch heap health for long unattended runs
+  heapMonitorBegin();
+  
+  // Restore settings and go back to sniffing if we were
+  settingsBegin();
+  if (!restoreLastMode()) {
+    showMainMenu();
+  }
+  bootTiming.firstScreen = millis();
 }
 
 void loop() {
@@ -34,7 +44,7 @@ void loop() {
   if (currentState == INFO_MODE && infoPage == 0 && selectedNetwork >= 0) {
     if (networks[selectedNetwork].ssid.length() > 16 && 
         millis() - lastScroll > SCROLL_DELAY) {
-      textOffset = (textOffset + 1) % (networks[selectedNetwork].ssid.length() - 6);
+      textOffset = (textOffset + 1) % ((int)networks[selectedNetwork].ssid.length() - 6);
       lastScroll = millis();
       showInfoScreen();
     }
@@ -42,21 +52,26 @@ void loop() {
   
   // Auto-scan in SCAN mode
   if (currentState == SCAN_MODE) {
-    int scanStatus = WiFi.scanComplete();
-    if (scanStatus > 0) {
-      processScanResults(scanStatus);
-      currentState = SCAN_RESULTS;
-      scrollPos = 0;
-      showScanResults();
-    } else if (scanStatus == 0) {
-      lcd.clear();
-      lcd.print("No networks!");
-      delay(1000);
-      currentState = MAIN_MENU;
-      showMainMenu();
-    }
+    updateScanMode();
   }
   
+  // Refresh heap statistics, live on the diagnostics page
+  if (updateHeapMonitor() && currentState == DIAG_MODE) {
+    showDiagScreen();
+  }
+  
+  // Periodic survey scans into flash history
+  updateBackgroundSurvey();
+  
+  // Read-only status dashboard
+  updateStatusServer();
+  
+  // Export and maintenance commands
+  handleSerialCommands();
+  
+  // Print boot timing once the target is captured
+  updateBootTiming();
+  
   // Update attack modes
   if (currentState == PS_MODE) {
     updatePSMode();
@@ -68,11 +83,4 @@ void loop() {
     updateAPMode();
     apServer.handleClient();
   }
-  
-  // Update packet counter every second
-  if ((currentState == PS_MODE || currentState == MITM_MODE) && 
-      millis() - lastPacketReset > PACKET_WINDOW) {
-    lastPacketReset = millis();
-    packetCount = 0;  // Reset counter
-  }
 }
@@ -0,0 +1,37 @@
+function cell(row, text, cls) {
+  var td = row.insertCell();
+  td.textContent = text;
+  if (cls) td.className = cls;
+}
+
+function fill(id, url, render) {
+  fetch(url).then(function (r) { return r.json(); }).then(function (items) {
+    var body = document.getElementById(id);
+    body.textContent = '';
+    items.forEach(function (item) { render(body.insertRow(), item); });
+  });
+}
+
+function refreshTables() {
+  fill('networks', '/api/networks', function (row, n) {
+    cell(row, n.ssid); cell(row, n.bssid); cell(row, n.ch); cell(row, n.rssi); cell(row, n.sec);
+  });
+  fill('alerts', '/api/alerts', function (row, a) {
+    cell(row, a.bssid, 'alert'); cell(row, a.flags, 'alert'); cell(row, a.jitter); cell(row, a.drift);
+  });
+}
+
+var events = new EventSource('/events');
+events.addEventListener('stats', function (e) {
+  var s = JSON.parse(e.data);
+  var out = document.getElementById('stats');
+  out.textContent = '';
+  Object.keys(s).forEach(function (k) {
+    var span = document.createElement('span');
+    span.textContent = k + ': ' + s[k];
+    out.appendChild(span);
+  });
+});
+
+refreshTables();
+setInterval(refreshTables, 10000);
@@ -0,0 +1,156 @@
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+// Heap-free string types. Arduino String reallocates on every concatenation
+// and fragments the heap over long runs; these keep their characters inline
+// and silently truncate at capacity.
+
+// Non-owning view of a character range, printable without copying
+class StrView : public Printable {
+ public:
+  StrView() : text(""), len(0) {}
+  StrView(const char* s) : text(s), len(strlen(s)) {}
+  StrView(const char* s, size_t n) : text(s), len(n) {}
+
+  const char* data() const { return text; }
+  size_t length() const { return len; }
+
+  StrView substr(size_t start, size_t count = (size_t)-1) const {
+    if (start > len) start = len;
+    if (count > len - start) count = len - start;
+    return StrView(text + start, count);
+  }
+
+  bool operator==(const char* other) const {
+    return strlen(other) == len && memcmp(text, other, len) == 0;
+  }
+
+  size_t printTo(Print& p) const override {
+    return p.write((const uint8_t*)text, len);
+  }
+
+ private:
+  const char* text;
+  size_t len;
+};
+
+// Inline string of up to N - 1 characters
+template <size_t N>
+class FixedString {
+ public:
+  FixedString() { clear(); }
+  FixedString(const char* s) { assign(s); }
+
+  void clear() {
+    len = 0;
+    buf[0] = '\0';
+  }
+
+  FixedString& assign(const char* s) {
+    clear();
+    return append(s);
+  }
+
+  FixedString& append(const char* s) { return append(s, strlen(s)); }
+
+  FixedString& append(const char* s, size_t n) {
+    size_t room = N - 1 - len;
+    if (n > room) n = room;
+    memcpy(buf + len, s, n);
+    len += n;
+    buf[len] = '\0';
+    return *this;
+  }
+
+  FixedString& append(char c) {
+    if (len < N - 1) {
+      buf[len++] = c;
+      buf[len] = '\0';
+    }
+    return *this;
+  }
+
+  FixedString& append(StrView v) { return append(v.data(), v.length()); }
+
+  FixedString& appendf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, fmt);
+    int written = vsnprintf(buf + len, N - len, fmt, args);
+    va_end(args);
+    if (written > 0) {
+      len = min(len + (size_t)written, N - 1);
+    }
+    return *this;
+  }
+
+  FixedString& operator=(const char* s) { return assign(s); }
+  FixedString& operator+=(const char* s) { return append(s); }
+  FixedString& operator+=(char c) { return append(c); }
+
+  bool operator==(const char* s) const { return strcmp(buf, s) == 0; }
+
+  const char* c_str() const { return buf; }
+  size_t length() const { return len; }
+  bool empty() const { return len == 0; }
+  static size_t capacity() { return N - 1; }
+  StrView view() const { return StrView(buf, len); }
+
+ private:
+  char buf[N];
+  size_t len;
+};
+
+// Fixed-capacity log of strings that drops the oldest entry when full.
+// Entries are indexed oldest first. LogList is the capacity-independent
+// interface so different sized logs can be handled alike.
+template <size_t Len>
+class LogList {
+ public:
+  void push(const char* entry) {
+    entries[(start + count) % cap] = entry;
+    if (count < cap) {
+      count++;
+    } else {
+      start = (start + 1) % cap;
+    }
+  }
+
+  const FixedString<Len>& operator[](size_t i) const { return entries[(start + i) % cap]; }
+  const FixedString<Len>& back() const { return (*this)[count - 1]; }
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  size_t capacity() const { return cap; }
+
+  void clear() {
+    start = 0;
+    count = 0;
+  }
+
+ protected:
+  LogList(FixedString<Len>* storage, size_t capacity)
+    : entries(storage), cap(capacity), start(0), count(0) {}
+
+ private:
+  FixedString<Len>* entries;
+  size_t cap;
+  size_t start;
+  size_t count;
+};
+
+template <size_t Cap, size_t Len>
+class LogRing : public LogList<Len> {
+ public:
+  LogRing() : LogList<Len>(storage, Cap) {}
+
+  // LogList points at storage, so a copy would still use the source's
+  LogRing(const LogRing&) = delete;
+  LogRing& operator=(const LogRing&) = delete;
+
+ private:
+  FixedString<Len> storage[Cap];
+};
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef FRAME_DECODER_H
+#define FRAME_DECODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// 802.11 header decoding shared by the firmware and the host tools in
+// tools/, so both count frames the same way. Keep this header free of
+// Arduino and ESP-IDF dependencies.
+
+#define FRAME_TYPE_MGMT 0
+#define FRAME_TYPE_CTRL 1
+#define FRAME_TYPE_DATA 2
+
+#define MGMT_SUBTYPE_PROBE_RESP 5
+#define MGMT_SUBTYPE_BEACON 8
+#define CTRL_SUBTYPE_CTS 12
+#define CTRL_SUBTYPE_ACK 13
+
+struct FrameInfo {
+  uint8_t type;
+  uint8_t subtype;
+  bool toDS;
+  bool fromDS;
+  bool retry;
+  bool hasSeq;
+  uint16_t seq;
+  uint8_t frag;
+  bool qos;
+  uint8_t tid;  // QoS data only; each TID has its own sequence counter
+
+  // Pointers into the frame; null when the frame does not carry them
+  const uint8_t* addr1;  // receiver
+  const uint8_t* addr2;  // transmitter
+  const uint8_t* addr3;
+  const uint8_t* bssid;
+
+  // Beacon and probe response body
+  bool hasBeaconBody;
+  uint64_t tsf;
+  uint16_t intervalTU;
+  uint8_t channel;  // DS parameter set, 0 when absent
+  const uint8_t* ssid;
+  uint8_t ssidLen;
+};
+
+// Decodes the header of a frame of len bytes (a trailing FCS is allowed).
+// Returns false when the frame is too short or not a version 0 frame.
+static inline bool decodeFrame(const uint8_t* frame, size_t len, FrameInfo& info) {
+  memset(&info, 0, sizeof(info));
+  if (len < 10 || (frame[0] & 0x03) != 0) return false;
+
+  info.type = (frame[0] >> 2) & 0x03;
+  info.subtype = frame[0] >> 4;
+  info.toDS = frame[1] & 0x01;
+  info.fromDS = frame[1] & 0x02;
+  info.retry = frame[1] & 0x08;
+  info.addr1 = frame + 4;
+
+  if (info.type == FRAME_TYPE_CTRL) {
+    // CTS and ACK carry only the receiver address
+    if (len >= 16 && info.subtype != CTRL_SUBTYPE_CTS && info.subtype != CTRL_SUBTYPE_ACK) {
+      info.addr2 = frame + 10;
+    }
+    return true;
+  }
+
+  if (len < 24) return false;
+  info.addr2 = frame + 10;
+  info.addr3 = frame + 16;
+
+  uint16_t seqCtrl = frame[22] | (frame[23] << 8);
+  info.hasSeq = true;
+  info.seq = seqCtrl >> 4;
+  info.frag = seqCtrl & 0x0F;
+
+  if (!info.toDS && !info.fromDS) {
+    info.bssid = info.addr3;
+  } else if (info.toDS && !info.fromDS) {
+    info.bssid = info.addr1;
+  } else if (!info.toDS && info.fromDS) {
+    info.bssid = info.addr2;
+  }
+
+  // QoS control follows the header, after addr4 on WDS frames
+  size_t qosPos = (info.toDS && info.fromDS) ? 30 : 24;
+  if (info.type == FRAME_TYPE_DATA && (info.subtype & 0x08) && len >= qosPos + 2) {
+    info.qos = true;
+    info.tid = frame[qosPos] & 0x0F;
+  }
+
+  // Beacon body: 8 byte TSF, 2 byte interval, 2 byte capabilities, then IEs
+  if (info.type == FRAME_TYPE_MGMT && len >= 36 &&
+      (info.subtype == MGMT_SUBTYPE_BEACON || info.subtype == MGMT_SUBTYPE_PROBE_RESP)) {
+    info.hasBeaconBody = true;
+    for (int i = 7; i >= 0; i--) {
+      info.tsf = (info.tsf << 8) | frame[24 + i];
+    }
+    info.intervalTU = frame[32] | (frame[33] << 8);
+
+    size_t pos = 36;
+    while (pos + 2 <= len) {
+      uint8_t id = frame[pos];
+      uint8_t ieLen = frame[pos + 1];
+      if (pos + 2 + ieLen > len) break;
+      if (id == 0 && ieLen <= 32) {
+        info.ssid = frame + pos + 2;
+        info.ssidLen = ieLen;
+      } else if (id == 3 && ieLen == 1) {
+        info.channel = frame[pos + 2];
+      }
+      pos += 2 + ieLen;
+    }
+  }
+
+  return true;
+}
+
+#endif
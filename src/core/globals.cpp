@@ -1,7 +1,7 @@
 #include "globals.h"
 
 // Initialize global variables
-LiquidCrystal lcd(14, 27, 26, 25, 33, 32);
+LcdMirror lcd(14, 27, 26, 25, 33, 32);
 
 // Joystick pins
 const int joyX = 35;
@@ -17,6 +17,7 @@ const char* attackMenuItems[] = {"PS", "MITM", "AP"};
 int menuIndex = 0;
 int attackMenuIndex = 0;
 int selectedNetwork = -1;
+int logIndex = 0;
 
 // Wi-Fi networks
 WiFiNetwork networks[20];
@@ -25,7 +26,11 @@ int scrollPos = 0;
 
 // Info page scrolling
 int infoPage = 0;
-const int INFO_PAGES = 3;
+const int INFO_PAGES = 4;
+
+// Diagnostics pages
+int diagPage = 0;
+const int DIAG_PAGES = 4;
 
 // Input filtering
 unsigned long lastAction = 0;
@@ -43,15 +48,13 @@ unsigned long lastPacketReset = 0;
 const int PACKET_WINDOW = 1000;
 
 // Packet sniffing variables
-std::vector<String> packetLogs;
+LogRing<MAX_PACKET_LOGS, LOG_ENTRY_LEN> packetLogs;
 unsigned long lastPacketLog = 0;
-const int MAX_PACKET_LOGS = 20;
 
 // MITM variables
-std::vector<String> mitmLogs;
-std::vector<String> mitmCredentials;
+LogRing<MAX_MITM_LOGS, LOG_ENTRY_LEN> mitmLogs;
+LogRing<MAX_CREDENTIAL_LOGS, LOG_ENTRY_LEN> mitmCredentials;
 unsigned long lastMitmLog = 0;
-const int MAX_MITM_LOGS = 30;
 WebServer mitmServer(80);
 DNSServer mitmDnsServer;
 IPAddress apIP(192, 168, 4, 1);
@@ -60,12 +63,12 @@ bool isCaptivePortal = true;
 int mitmPage = 0;
 
 // AP mode variables
-String apSSID = "Weak_WiFi(hackme)";
-String apPassword = "";
+const char* apSSID = "Weak_WiFi(hackme)";
+const char* apPassword = "";
 unsigned int apClientCount = 0;
 unsigned long lastAPUpdate = 0;
-std::vector<String> apLogs;
-std::vector<String> connectedDevices;
+LogRing<MAX_AP_LOGS, LOG_ENTRY_LEN> apLogs;
+LogRing<MAX_AP_DEVICES, 18> connectedDevices;
 WebServer apServer(80);
 int apPage = 0;
 
@@ -75,3 +78,36 @@ int dnsCount = 0;
 int arpCount = 0;
 int tcpCount = 0;
 int udpCount = 0;
+
+// Beacon timing analysis
+BeaconTrack beaconTracks[MAX_BEACON_TRACKS];
+
+// Per-link loss analysis; rate buckets hold rates up to each limit in Mbps
+LinkStats links[MAX_LINKS];
+const uint8_t LINK_RATE_LIMITS[LINK_RATE_BUCKETS] = { 2, 6, 12, 24, 36, 54, 72, 255 };
+
+// Background survey
+unsigned long lastSurveyScan = 0;
+const unsigned long SURVEY_INTERVAL = 60000;
+bool surveyScanPending = false;
+
+// Heap monitor
+HeapStats heapStats = {};
+const unsigned long HEAP_SAMPLE_INTERVAL = 1000;
+
+// Status dashboard on the management AP
+WebServer statusServer(8080);
+IPAddress mgmtIP(192, 168, 5, 1);
+const char* MGMT_SSID = "Striker-Mgmt";
+const char* STATUS_USER = "admin";
+FixedString<DASHBOARD_PASSWORD_MAX + 1> dashboardPassword;
+bool statusServerEnabled = false;
+StatusServerStats statusStats = {};
+
+// Capture summary
+Snapshot<CaptureStats> captureSnapshot;
+Snapshot<TableSummary> tableSnapshot;
+Snapshot<PacketLogSummary> packetLogSnapshot;
+
+// Boot timing
+BootTiming bootTiming = {};
@@ -6,11 +6,13 @@
 #include <esp_wifi.h>
 #include <WebServer.h>
 #include <DNSServer.h>
-#include <vector>
 #include <algorithm>
+#include "fixed_string.h"
+#include "snapshot.h"
+#include "../output/lcd_mirror.h"
 
 // LCD setup (4-bit interface)
-extern LiquidCrystal lcd;
+extern LcdMirror lcd;
 
 // Joystick pins
 extern const int joyX;
@@ -20,7 +22,8 @@ extern const int joyBtn;
 // Application states
 enum AppState { 
   MAIN_MENU, SCAN_MODE, SCAN_RESULTS, SELECT_MODE, INFO_MODE, 
-  ATTACK_MODE, ATTACK_MENU, PS_MODE, MITM_MODE, AP_MODE 
+  ATTACK_MODE, ATTACK_MENU, PS_MODE, MITM_MODE, AP_MODE, DIAG_MODE,
+  STATE_COUNT
 };
 extern AppState currentState;
 
@@ -30,14 +33,15 @@ extern const char* attackMenuItems[];
 extern int menuIndex;
 extern int attackMenuIndex;
 extern int selectedNetwork;
+extern int logIndex;
 
 // Wi-Fi networks
 struct WiFiNetwork {
-  String ssid;
+  FixedString<33> ssid;
   int32_t rssi;
   uint8_t channel;
-  String bssid;
-  String encryption;
+  FixedString<18> bssid;
+  const char* encryption;
 };
 extern WiFiNetwork networks[20];
 extern int networkCount;
@@ -47,6 +51,10 @@ extern int scrollPos;
 extern int infoPage;
 extern const int INFO_PAGES;
 
+// Diagnostics pages
+extern int diagPage;
+extern const int DIAG_PAGES;
+
 // Input filtering
 extern unsigned long lastAction;
 extern const int DEBOUNCE_DELAY;
@@ -62,16 +70,23 @@ extern uint8_t targetBSSID[6];
 extern unsigned long lastPacketReset;
 extern const int PACKET_WINDOW;
 
+// Log buffers
+#define LOG_ENTRY_LEN 48
+#define MAX_PACKET_LOGS 20
+#define MAX_MITM_LOGS 30
+#define MAX_CREDENTIAL_LOGS 10
+#define MAX_AP_LOGS 20
+#define MAX_AP_DEVICES 10
+
 // Packet sniffing variables
-extern std::vector<String> packetLogs;
+// packetLogs is the callback's; readers use packetLogSnapshot
+extern LogRing<MAX_PACKET_LOGS, LOG_ENTRY_LEN> packetLogs;
 extern unsigned long lastPacketLog;
-extern const int MAX_PACKET_LOGS;
 
 // MITM variables
-extern std::vector<String> mitmLogs;
-extern std::vector<String> mitmCredentials;
+extern LogRing<MAX_MITM_LOGS, LOG_ENTRY_LEN> mitmLogs;
+extern LogRing<MAX_CREDENTIAL_LOGS, LOG_ENTRY_LEN> mitmCredentials;
 extern unsigned long lastMitmLog;
-extern const int MAX_MITM_LOGS;
 extern WebServer mitmServer;
 extern DNSServer mitmDnsServer;
 extern IPAddress apIP;
@@ -80,12 +95,12 @@ extern bool isCaptivePortal;
 extern int mitmPage;
 
 // AP mode variables
-extern String apSSID;
-extern String apPassword;
+extern const char* apSSID;
+extern const char* apPassword;
 extern unsigned int apClientCount;
 extern unsigned long lastAPUpdate;
-extern std::vector<String> apLogs;
-extern std::vector<String> connectedDevices;
+extern LogRing<MAX_AP_LOGS, LOG_ENTRY_LEN> apLogs;
+extern LogRing<MAX_AP_DEVICES, 18> connectedDevices;
 extern WebServer apServer;
 extern int apPage;
 
@@ -96,4 +111,207 @@ extern int arpCount;
 extern int tcpCount;
 extern int udpCount;
 
+// Beacon timing analysis
+#define BEACON_HISTORY 8
+#define MAX_BEACON_TRACKS 16
+#define BEACON_JITTER_LIMIT_US 4000
+#define BEACON_DRIFT_LIMIT_PPM 200
+
+enum BeaconAnomaly : uint8_t {
+  BEACON_TSF_RESET = 0x01,
+  BEACON_SEQ_ORDER = 0x02,
+  BEACON_JITTER = 0x04,
+  BEACON_DRIFT = 0x08
+};
+
+struct BeaconTrack {
+  uint8_t bssid[6];
+  bool used;
+  uint16_t intervalTU;
+  uint32_t lastSeen;
+  uint32_t beacons;
+
+  // Ring of the last BEACON_HISTORY beacons
+  uint8_t head;
+  uint8_t count;
+  uint32_t arrival[BEACON_HISTORY];
+  uint64_t tsf[BEACON_HISTORY];
+  uint16_t seq[BEACON_HISTORY];
+  int32_t delta[BEACON_HISTORY];
+  int32_t jitter[BEACON_HISTORY];
+  int32_t drift[BEACON_HISTORY];
+
+  // Running sums over the ring, updated as samples enter and leave
+  uint8_t deltas;
+  uint64_t sumDelta;
+  int64_t sumJitter;
+  int64_t sumDrift;
+
+  uint8_t flags;
+  uint16_t tsfResets;
+  uint16_t seqAnomalies;
+  uint16_t jitterAnomalies;
+  uint16_t driftAnomalies;
+};
+extern BeaconTrack beaconTracks[MAX_BEACON_TRACKS];
+
+// Per-link loss analysis, keyed by (transmitter, receiver)
+#define MAX_LINKS 16
+#define LINK_RATE_BUCKETS 8
+#define LINK_MAX_GAP 64    // larger sequence jumps are a resync, not loss
+#define LINK_EWMA_SHIFT 5  // recent rates weigh the last ~32 frames
+
+struct LinkStats {
+  uint8_t ta[6];
+  uint8_t ra[6];
+  bool used;
+  uint32_t lastSeen;
+
+  // Last sequence number per QoS TID; other frames share counters we
+  // cannot see (beacons, non-QoS data to other stations)
+  uint16_t lastSeq[8];
+  uint8_t seqValid;
+  uint32_t frames;
+  uint32_t retries;
+  uint32_t lost;        // frames missing from sequence gaps
+  uint32_t duplicates;  // retries of frames we already saw
+  uint32_t resyncs;
+
+  // Recent loss and retry rates, Q16 (65536 = 100%)
+  int32_t lossEwma;
+  int32_t retryEwma;
+
+  uint32_t rates[LINK_RATE_BUCKETS];
+};
+extern LinkStats links[MAX_LINKS];
+extern const uint8_t LINK_RATE_LIMITS[LINK_RATE_BUCKETS];
+
+// Background survey
+extern unsigned long lastSurveyScan;
+extern const unsigned long SURVEY_INTERVAL;
+extern bool surveyScanPending;
+
+// Heap monitor
+struct HeapStats {
+  uint32_t freeBytes;
+  uint32_t minFreeBytes;
+  uint32_t largestBlock;
+  uint32_t worstLargestBlock;
+  uint32_t allocatedBlocks;
+  uint32_t freeBlocks;
+  int32_t blockGrowth;
+  uint8_t fragmentation;
+  uint32_t failedAllocs;
+  uint32_t lastFailedSize;
+  uint32_t samples;
+};
+extern HeapStats heapStats;
+extern const unsigned long HEAP_SAMPLE_INTERVAL;
+
+// Status dashboard on the management AP
+extern WebServer statusServer;
+extern IPAddress mgmtIP;
+// One password for the WPA2 AP and HTTP auth, set over serial and kept
+// in NVS. Empty until set; the AP does not start without it.
+#define DASHBOARD_PASSWORD_MIN 8    // WPA2 passphrase limits
+#define DASHBOARD_PASSWORD_MAX 63
+extern const char* MGMT_SSID;
+extern const char* STATUS_USER;
+extern FixedString<DASHBOARD_PASSWORD_MAX + 1> dashboardPassword;
+extern bool statusServerEnabled;
+
+struct StatusServerStats {
+  uint32_t requests;
+  uint32_t requestsPerSec;
+  uint32_t peakRequestsPerSec;
+  uint32_t heapPerRequest;
+  uint32_t heapPerStream;
+};
+extern StatusServerStats statusStats;
+
+// Capture summary, written only by the promiscuous callback. The UI,
+// serial console and dashboard read it through captureSnapshot instead
+// of the live counters.
+#define CAPTURE_PUBLISH_INTERVAL 100
+
+struct CaptureStats {
+  uint32_t publishedAt;
+  uint32_t frames;          // since PS mode started
+  uint32_t framesPerWindow; // frames in the last full PACKET_WINDOW
+  int http;
+  int dns;
+  int arp;
+  int tcp;
+  int udp;
+  int suspectAps;
+
+  // Target beacon timing
+  bool targetSeen;
+  uint8_t targetFlags;
+  int32_t targetJitterUs;
+  int32_t targetDriftPpm;
+
+  // Worst link in the target BSS
+  bool hasLink;
+  uint8_t linkTa[6];
+  uint8_t linkRa[6];
+  uint8_t linkRate;
+  uint16_t linkLoss;
+  uint16_t linkRetry;
+};
+extern Snapshot<CaptureStats> captureSnapshot;
+
+// Bounded copy of the beacon and link tables, published next to the
+// capture summary so /api/alerts and `links` never walk the live tables
+#define SUMMARY_ALERTS 8
+#define SUMMARY_LINKS 8
+
+struct AlertRow {
+  uint8_t bssid[6];
+  uint8_t flags;
+  int32_t jitterUs;
+  int32_t driftPpm;
+};
+
+struct LinkRow {
+  uint8_t ta[6];
+  uint8_t ra[6];
+  uint32_t frames;
+  uint32_t retries;
+  uint32_t lost;
+  uint32_t duplicates;
+  uint32_t resyncs;
+  uint16_t lossPermille;
+  uint16_t retryPermille;
+  uint16_t recentLossPermille;
+  uint16_t recentRetryPermille;
+  uint32_t rates[LINK_RATE_BUCKETS];
+};
+
+struct TableSummary {
+  uint8_t alertCount;
+  uint8_t linkCount;
+  uint8_t linksTracked;     // links in the live table, may exceed linkCount
+  AlertRow alerts[SUMMARY_ALERTS];
+  LinkRow links[SUMMARY_LINKS];  // worst first
+};
+extern Snapshot<TableSummary> tableSnapshot;
+
+// Copy of packetLogs, published by the callback each time it logs a
+// frame so the log scroll never reads the ring while it is written
+struct PacketLogSummary {
+  uint8_t count;
+  FixedString<LOG_ENTRY_LEN> entries[MAX_PACKET_LOGS];  // oldest first
+};
+extern Snapshot<PacketLogSummary> packetLogSnapshot;
+
+// Boot timing, in ms since start (0 = not reached yet)
+struct BootTiming {
+  uint32_t firstScreen;
+  uint32_t firstFrame;    // any frame from the radio
+  uint32_t firstCapture;  // first frame from the target network
+  bool resumed;
+};
+extern BootTiming bootTiming;
+
 #endif
@@ -0,0 +1,55 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <atomic>
+#include <stdint.h>
+
+// Seqlock around a plain struct: one writer publishes whole copies, any
+// number of readers take consistent copies without locks. The writer
+// never waits; a reader that overlaps a publish retries.
+//
+// The writer (the Wi-Fi callback) runs at a higher priority than every
+// reader, so a reader can never stall a publish halfway. T must be
+// trivially copyable.
+template <typename T>
+class Snapshot {
+ public:
+  Snapshot() : seq(0), value() {}
+
+  // Single writer only
+  void publish(const T& next) {
+    uint32_t s = seq.load(std::memory_order_relaxed);
+    seq.store(s + 1, std::memory_order_relaxed);  // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    value = next;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    seq.store(s + 2, std::memory_order_release);
+  }
+
+  // False if a publish overlapped the copy
+  bool tryRead(T& out) const {
+    uint32_t before = seq.load(std::memory_order_acquire);
+    if (before & 1) return false;
+    out = value;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return seq.load(std::memory_order_relaxed) == before;
+  }
+
+  T read() const {
+    T out;
+    while (!tryRead(out)) {
+    }
+    return out;
+  }
+
+  // Number of completed publishes
+  uint32_t version() const {
+    return seq.load(std::memory_order_acquire) / 2;
+  }
+
+ private:
+  std::atomic<uint32_t> seq;
+  T value;
+};
+
+#endif
@@ -1,176 +1,276 @@
 #include "input_handler.h"
+#include "input_trace.h"
 #include "../output/lcd_handler.h"
 #include "../modules/wifi_scanner.h"
 #include "../modules/attack_modes.h"
+#include "../modules/packet_analyzer.h"
+#include "../modules/status_server.h"
+#include "../modules/settings.h"
+
+typedef void (*UiAction)();
+
+// next == KEEP_STATE leaves the state (and drawing) to the action,
+// for entries like enterPSMode() that may fail and fall back.
+// Otherwise the state is set after the action and its renderer runs.
+#define KEEP_STATE 0xFF
+
+struct UiTransition {
+  UiAction action;
+  uint8_t next;
+};
+
+// Actions
+static void menuUp() {
+  menuIndex = (menuIndex == 0) ? 3 : menuIndex - 1;
+}
+
+static void menuDown() {
+  menuIndex = (menuIndex == 3) ? 0 : menuIndex + 1;
+}
+
+static void openMenuItem() {
+  switch(menuIndex) {
+    case 0: enterScanMode(); break;
+    case 1: enterSelectMode(); break;
+    case 2: enterAttackMode(); break;
+    case 3: enterInfoMode(); break;
+  }
+}
+
+static void goHome() {
+  infoPage = 0;
+  textOffset = 0;
+}
+
+static void networkUp() {
+  if (networkCount > 0) {
+    scrollPos = (scrollPos > 0) ? scrollPos - 1 : networkCount - 1;
+  }
+}
+
+static void networkDown() {
+  if (networkCount > 0) {
+    scrollPos = (scrollPos + 1) % networkCount;
+  }
+}
+
+static void selectNetwork() {
+  selectedNetwork = scrollPos;
+  saveSettings();
+  lcd.clear();
+  lcd.print("Selected:");
+  lcd.setCursor(0, 1);
+  printEllipsized(networks[scrollPos].ssid.view(), 16);
+  uiPause(2000);
+}
+
+static void infoUp() {
+  infoPage = (infoPage == 0) ? INFO_PAGES - 1 : infoPage - 1;
+  textOffset = 0;
+}
+
+static void infoDown() {
+  infoPage = (infoPage + 1) % INFO_PAGES;
+  textOffset = 0;
+}
+
+static void attackUp() {
+  attackMenuIndex = (attackMenuIndex == 0) ? 2 : attackMenuIndex - 1;
+}
+
+static void attackDown() {
+  attackMenuIndex = (attackMenuIndex + 1) % 3;
+}
+
+static void openAttack() {
+  logIndex = 0;
+  switch(attackMenuIndex) {
+    case 0: enterPSMode(); break;
+    case 1: enterMITMMode(); break;
+    case 2: enterAPMode(); break;
+  }
+}
+
+static void stopAttack() {
+  // Stop any active attack mode; the dashboard restarts on its own
+  saveResumeMode(MAIN_MENU);
+  statusServerStop();
+  esp_wifi_set_promiscuous(false);
+  WiFi.softAPdisconnect(true);
+  mitmServer.stop();
+  apServer.stop();
+  WiFi.mode(WIFI_STA);
+}
+
+// The UI's copy of packetLogs, which belongs to the capture callback
+static LogRing<MAX_PACKET_LOGS, LOG_ENTRY_LEN> packetLogView;
+
+// Log shown by up/down in the current attack mode page, if any
+static LogList<LOG_ENTRY_LEN>* activeLog() {
+  if (currentState == PS_MODE) {
+    readPacketLogs(packetLogView);
+    return &packetLogView;
+  }
+  if (currentState == MITM_MODE && mitmPage == 1) return &mitmCredentials;
+  if (currentState == AP_MODE && apPage == 1) return &apLogs;
+  return nullptr;
+}
+
+static void showLogEntry(LogList<LOG_ENTRY_LEN>* logs) {
+  lcd.clear();
+  lcd.printf("Log %d/%d", logIndex + 1, (int)logs->size());
+  lcd.setCursor(0, 1);
+  lcd.print((*logs)[logIndex].view().substr(0, 16));
+}
+
+static void logUp() {
+  LogList<LOG_ENTRY_LEN>* logs = activeLog();
+  if (!logs || logs->empty()) return;
+  int size = logs->size();
+  logIndex = (logIndex > 0 && logIndex < size) ? logIndex - 1 : size - 1;
+  showLogEntry(logs);
+}
+
+static void logDown() {
+  LogList<LOG_ENTRY_LEN>* logs = activeLog();
+  if (!logs || logs->empty()) return;
+  logIndex = (logIndex + 1) % logs->size();
+  showLogEntry(logs);
+}
+
+static void mitmNextPage() {
+  mitmPage = (mitmPage + 1) % 2;
+  logIndex = 0;
+  updateMITMMode();
+}
+
+static void apNextPage() {
+  apPage = (apPage + 1) % 2;
+  logIndex = 0;
+  updateAPMode();
+}
+
+static void diagUp() {
+  diagPage = (diagPage == 0) ? DIAG_PAGES - 1 : diagPage - 1;
+}
+
+static void diagDown() {
+  diagPage = (diagPage + 1) % DIAG_PAGES;
+}
+
+static void openDiag() {
+  diagPage = 0;
+}
+
+static_assert(STATE_COUNT == 11, "update the UI tables when adding a state");
+
+// Screen drawn on entering (or staying in) each state
+static const UiAction renderers[STATE_COUNT] = {
+  /* MAIN_MENU    */ showMainMenu,
+  /* SCAN_MODE    */ nullptr,
+  /* SCAN_RESULTS */ showScanResults,
+  /* SELECT_MODE  */ showSelectScreen,
+  /* INFO_MODE    */ showInfoScreen,
+  /* ATTACK_MODE  */ nullptr,
+  /* ATTACK_MENU  */ showAttackMenu,
+  /* PS_MODE      */ nullptr,
+  /* MITM_MODE    */ nullptr,
+  /* AP_MODE      */ nullptr,
+  /* DIAG_MODE    */ showDiagScreen,
+};
+
+#define NONE { nullptr, KEEP_STATE }
+
+// (state, event) -> (action, next state)
+static const UiTransition transitions[STATE_COUNT][EVENT_COUNT] = {
+  /* MAIN_MENU */ {
+    { menuUp, MAIN_MENU }, { menuDown, MAIN_MENU },
+    { nullptr, MAIN_MENU }, { openMenuItem, KEEP_STATE }, { openDiag, DIAG_MODE } },
+  /* SCAN_MODE */ {
+    NONE, NONE, { goHome, MAIN_MENU }, NONE, NONE },
+  /* SCAN_RESULTS */ {
+    { networkUp, SCAN_RESULTS }, { networkDown, SCAN_RESULTS },
+    { goHome, MAIN_MENU }, NONE, NONE },
+  /* SELECT_MODE */ {
+    { networkUp, SELECT_MODE }, { networkDown, SELECT_MODE },
+    { goHome, MAIN_MENU }, { selectNetwork, SELECT_MODE }, NONE },
+  /* INFO_MODE */ {
+    { infoUp, INFO_MODE }, { infoDown, INFO_MODE }, { goHome, MAIN_MENU }, NONE, NONE },
+  /* ATTACK_MODE */ {
+    NONE, NONE, { goHome, MAIN_MENU }, NONE, NONE },
+  /* ATTACK_MENU */ {
+    { attackUp, ATTACK_MENU }, { attackDown, ATTACK_MENU },
+    { nullptr, MAIN_MENU }, { openAttack, KEEP_STATE }, NONE },
+  /* PS_MODE */ {
+    { logUp, KEEP_STATE }, { logDown, KEEP_STATE }, { stopAttack, ATTACK_MENU }, NONE, NONE },
+  /* MITM_MODE */ {
+    { logUp, KEEP_STATE }, { logDown, KEEP_STATE }, { stopAttack, ATTACK_MENU },
+    NONE, { mitmNextPage, KEEP_STATE } },
+  /* AP_MODE */ {
+    { logUp, KEEP_STATE }, { logDown, KEEP_STATE }, { stopAttack, ATTACK_MENU },
+    NONE, { apNextPage, KEEP_STATE } },
+  /* DIAG_MODE */ {
+    { diagUp, DIAG_MODE }, { diagDown, DIAG_MODE }, { goHome, MAIN_MENU }, NONE, NONE },
+};
+
+#undef NONE
+
+void dispatchEvent(UiEvent event) {
+  unsigned long start = micros();
+  AppState from = currentState;
+
+  const UiTransition& t = transitions[from][event];
+  if (t.action) {
+    t.action();
+  }
+  if (t.next != KEEP_STATE) {
+    currentState = (AppState)t.next;
+    if (renderers[currentState]) {
+      renderers[currentState]();
+    }
+  }
+
+  recordTrace(event, from, micros() - start);
+}
+
+// Back to the main menu from any state, shutting down a running mode
+// the same way the joystick does
+void returnToMainMenu() {
+  if (currentState == PS_MODE || currentState == MITM_MODE || currentState == AP_MODE) {
+    stopAttack();
+  }
+  currentState = MAIN_MENU;
+  menuIndex = 0;
+  goHome();
+  showMainMenu();
+}
 
 void handleJoystick() {
   int xVal = analogRead(joyX);
   int yVal = analogRead(joyY);
   bool btnPressed = digitalRead(joyBtn) == LOW;
 
-  if (btnPressed && millis() - lastAction > DEBOUNCE_DELAY) {
-    // Button press to switch between pages in MITM and AP modes
-    if (currentState == MITM_MODE) {
-      mitmPage = (mitmPage + 1) % 2;
-      lastAction = millis();
-      updateMITMMode();
-    } else if (currentState == AP_MODE) {
-      apPage = (apPage + 1) % 2;
-      lastAction = millis();
-      updateAPMode();
-    }
+  if (btnPressed && millis() - lastAction > DEBOUNCE_DELAY &&
+      transitions[currentState][EV_BUTTON].action) {
+    dispatchEvent(EV_BUTTON);
+    lastAction = millis();
   }
   
   if (yVal < 1000) { // Up
-    handleUp();
+    dispatchEvent(EV_UP);
     lastAction = millis();
   } 
   else if (yVal > 3000) { // Down
-    handleDown();
+    dispatchEvent(EV_DOWN);
     lastAction = millis();
   }
   
   if (xVal < 1000) { // Left
-    handleLeft();
+    dispatchEvent(EV_LEFT);
     lastAction = millis();
   } 
   else if (xVal > 3000) { // Right
-    handleRight();
+    dispatchEvent(EV_RIGHT);
     lastAction = millis();
   }
 }
-
-void handleLeft() {
-  if (currentState == MAIN_MENU) {
-    showMainMenu();
-  } else if (currentState == ATTACK_MENU) {
-    currentState = MAIN_MENU;
-    showMainMenu();
-  } else if (currentState == PS_MODE || currentState == MITM_MODE || currentState == AP_MODE) {
-    // Stop any active attack mode
-    esp_wifi_set_promiscuous(false);
-    WiFi.softAPdisconnect(true);
-    mitmServer.stop();
-    apServer.stop();
-    WiFi.mode(WIFI_STA);
-    
-    currentState = ATTACK_MENU;
-    showAttackMenu();
-  } else {
-    currentState = MAIN_MENU;
-    infoPage = 0;
-    textOffset = 0;
-    showMainMenu();
-  }
-}
-
-void handleRight() {
-  if (currentState == MAIN_MENU) {
-    switch(menuIndex) {
-      case 0: enterScanMode(); break;
-      case 1: enterSelectMode(); break;
-      case 2: enterAttackMode(); break;
-      case 3: enterInfoMode(); break;
-    }
-  } else if (currentState == SELECT_MODE) {
-    selectedNetwork = scrollPos;
-    lcd.clear();
-    lcd.print("Selected:");
-    lcd.setCursor(0, 1);
-    
-    String displayText = networks[scrollPos].ssid;
-    if (displayText.length() > 16) {
-      displayText = displayText.substring(0, 13) + "...";
-    }
-    lcd.print(displayText);
-    
-    delay(2000);
-    showSelectScreen();
-  } else if (currentState == ATTACK_MENU) {
-    switch(attackMenuIndex) {
-      case 0: enterPSMode(); break;
-      case 1: enterMITMMode(); break;
-      case 2: enterAPMode(); break;
-    }
-  }
-}
-
-void handleUp() {
-  if (currentState == MAIN_MENU) {
-    menuIndex = (menuIndex == 0) ? 3 : menuIndex - 1;
-    showMainMenu();
-  } else if (currentState == SELECT_MODE || currentState == SCAN_RESULTS) {
-    if (networkCount > 0) {
-      scrollPos = (scrollPos > 0) ? scrollPos - 1 : networkCount - 1;
-      if (currentState == SELECT_MODE) {
-        showSelectScreen();
-      } else {
-        showScanResults();
-      }
-    }
-  } else if (currentState == INFO_MODE) {
-    infoPage = (infoPage == 0) ? INFO_PAGES - 1 : infoPage - 1;
-    textOffset = 0;
-    showInfoScreen();
-  } else if (currentState == ATTACK_MENU) {
-    attackMenuIndex = (attackMenuIndex == 0) ? 2 : attackMenuIndex - 1;
-    showAttackMenu();
-  } else if (currentState == PS_MODE || currentState == MITM_MODE || currentState == AP_MODE) {
-    // Scroll through logs
-    std::vector<String>* logs = nullptr;
-    if (currentState == PS_MODE) logs = &packetLogs;
-    else if (currentState == MITM_MODE && mitmPage == 1) logs = &mitmCredentials;
-    else if (currentState == AP_MODE && apPage == 1) logs = &apLogs;
-    
-    if (logs && logs->size() > 0) {
-      static int logIndex = 0;
-      logIndex = (logIndex > 0) ? logIndex - 1 : logs->size() - 1;
-      lcd.clear();
-      lcd.print("Log " + String(logIndex + 1) + "/" + String(logs->size()));
-      lcd.setCursor(0, 1);
-      String logEntry = (*logs)[logIndex];
-      int maxLen = min(16, (int)logEntry.length());
-      lcd.print(logEntry.substring(0, maxLen));
-    }
-  }
-}
-
-void handleDown() {
-  if (currentState == MAIN_MENU) {
-    menuIndex = (menuIndex == 3) ? 0 : menuIndex + 1;
-    showMainMenu();
-  } else if (currentState == SELECT_MODE || currentState == SCAN_RESULTS) {
-    if (networkCount > 0) {
-      scrollPos = (scrollPos + 1) % networkCount;
-      if (currentState == SELECT_MODE) {
-        showSelectScreen();
-      } else {
-        showScanResults();
-      }
-    }
-  } else if (currentState == INFO_MODE) {
-    infoPage = (infoPage + 1) % INFO_PAGES;
-    textOffset = 0;
-    showInfoScreen();
-  } else if (currentState == ATTACK_MENU) {
-    attackMenuIndex = (attackMenuIndex + 1) % 3;
-    showAttackMenu();
-  } else if (currentState == PS_MODE || currentState == MITM_MODE || currentState == AP_MODE) {
-    // Scroll through logs
-    std::vector<String>* logs = nullptr;
-    if (currentState == PS_MODE) logs = &packetLogs;
-    else if (currentState == MITM_MODE && mitmPage == 1) logs = &mitmCredentials;
-    else if (currentState == AP_MODE && apPage == 1) logs = &apLogs;
-    
-    if (logs && logs->size() > 0) {
-      static int logIndex = 0;
-      logIndex = (logIndex + 1) % logs->size();
-      lcd.clear();
-      lcd.print("Log " + String(logIndex + 1) + "/" + String(logs->size()));
-      lcd.setCursor(0, 1);
-      String logEntry = (*logs)[logIndex];
-      int maxLen = min(16, (int)logEntry.length());
-      lcd.print(logEntry.substring(0, maxLen));
-    }
-  }
-}
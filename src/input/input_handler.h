@@ -3,10 +3,10 @@
 
 #include "../core/globals.h"
 
+enum UiEvent { EV_UP, EV_DOWN, EV_LEFT, EV_RIGHT, EV_BUTTON, EVENT_COUNT };
+
 void handleJoystick();
-void handleUp();
-void handleDown();
-void handleLeft();
-void handleRight();
+void dispatchEvent(UiEvent event);
+void returnToMainMenu();
 
 #endif
@@ -0,0 +1,109 @@
+#include "input_trace.h"
+#include "../output/lcd_handler.h"
+
+// Ring of the most recent UI events with their dispatch latency. A trace
+// is written as event letters (U D L R B, plus H for "reset to the main
+// menu") so it can be pasted back into the replay command.
+struct TraceEntry {
+  uint32_t time;
+  uint32_t latencyUs;
+  uint8_t event;
+  uint8_t state;
+};
+
+static TraceEntry trace[TRACE_SIZE];
+static int traceHead = 0;
+static int traceCount = 0;
+static bool replaying = false;
+
+static const char EVENT_LETTERS[EVENT_COUNT] = { 'U', 'D', 'L', 'R', 'B' };
+
+static const char* const STATE_NAMES[STATE_COUNT] = {
+  "MAIN_MENU", "SCAN_MODE", "SCAN_RESULTS", "SELECT_MODE", "INFO_MODE",
+  "ATTACK_MODE", "ATTACK_MENU", "PS_MODE", "MITM_MODE", "AP_MODE", "DIAG_MODE"
+};
+
+const char* stateName(AppState state) {
+  return (state < STATE_COUNT) ? STATE_NAMES[state] : "?";
+}
+
+void recordTrace(UiEvent event, AppState from, uint32_t latencyUs) {
+  if (replaying) return;
+  TraceEntry& e = trace[traceHead];
+  e.time = millis();
+  e.latencyUs = latencyUs;
+  e.event = event;
+  e.state = from;
+  traceHead = (traceHead + 1) % TRACE_SIZE;
+  if (traceCount < TRACE_SIZE) traceCount++;
+}
+
+void clearTrace() {
+  traceHead = 0;
+  traceCount = 0;
+}
+
+void printTrace(Print& out) {
+  out.println("time_ms,event,state,latency_us");
+  FixedString<TRACE_SIZE + 1> letters;
+  for (int i = 0; i < traceCount; i++) {
+    const TraceEntry& e = trace[(traceHead - traceCount + i + TRACE_SIZE) % TRACE_SIZE];
+    out.printf("%lu,%c,%s,%lu\n", (unsigned long)e.time, EVENT_LETTERS[e.event],
+               STATE_NAMES[e.state], (unsigned long)e.latencyUs);
+    letters += EVENT_LETTERS[e.event];
+  }
+  out.printf("events: %s\n", letters.c_str());
+}
+
+bool replayActive() {
+  return replaying;
+}
+
+// Feed events through the UI table and print the resulting screen after
+// each one, so a recorded session can be checked against expected output.
+// Settings are not saved while replaying (except that stopping a real PS
+// session clears the resume flag), and attack modes are not entered: on
+// the device that would bring up real soft APs.
+void replayTrace(const char* events, Print& out) {
+  replaying = true;
+  uint32_t total = 0;
+  int count = 0;
+
+  for (const char* c = events; *c; c++) {
+    if (*c == 'H') {
+      AppState from = currentState;
+      unsigned long start = micros();
+      returnToMainMenu();
+      uint32_t latency = micros() - start;
+      out.printf("H %s -> MAIN_MENU %luus |%s|%s|\n", STATE_NAMES[from],
+                 (unsigned long)latency, lcd.line(0), lcd.line(1));
+      continue;
+    }
+
+    int event = -1;
+    for (int i = 0; i < EVENT_COUNT; i++) {
+      if (EVENT_LETTERS[i] == *c) event = i;
+    }
+    if (event < 0) continue;
+
+    if (currentState == ATTACK_MENU && event == EV_RIGHT) {
+      out.printf("%c ATTACK_MENU skipped, attack modes do not run in replay\n", *c);
+      continue;
+    }
+
+    AppState from = currentState;
+    unsigned long start = micros();
+    dispatchEvent((UiEvent)event);
+    uint32_t latency = micros() - start;
+    total += latency;
+    count++;
+
+    out.printf("%c %s -> %s %luus |%s|%s|\n", *c, STATE_NAMES[from], STATE_NAMES[currentState],
+               (unsigned long)latency, lcd.line(0), lcd.line(1));
+  }
+
+  if (count > 0) {
+    out.printf("%d events, mean %luus\n", count, (unsigned long)(total / count));
+  }
+  replaying = false;
+}
@@ -0,0 +1,16 @@
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include "../core/globals.h"
+#include "input_handler.h"
+
+#define TRACE_SIZE 64
+
+const char* stateName(AppState state);
+void recordTrace(UiEvent event, AppState from, uint32_t latencyUs);
+void clearTrace();
+void printTrace(Print& out);
+void replayTrace(const char* events, Print& out);
+bool replayActive();
+
+#endif
@@ -0,0 +1,112 @@
+#include "serial_commands.h"
+#include "../modules/packet_analyzer.h"
+#include "../modules/survey_history.h"
+#include "../modules/heap_monitor.h"
+#include "input_trace.h"
+#include "../modules/status_server.h"
+#include "../modules/settings.h"
+#include "../modules/link_analyzer.h"
+
+#define SERIAL_LINE_LEN 96
+
+// Takes the rest of the line as is: spaces are part of the password
+static void setDashboardPassword(const char* pw, size_t pwLen) {
+  if (pwLen < DASHBOARD_PASSWORD_MIN || pwLen > DASHBOARD_PASSWORD_MAX) {
+    Serial.printf("Password must be %d-%d characters\n", DASHBOARD_PASSWORD_MIN,
+                  DASHBOARD_PASSWORD_MAX);
+    return;
+  }
+  dashboardPassword.clear();
+  dashboardPassword.append(pw, pwLen);
+  saveDashboardPassword();
+  // Restart the AP with the new passphrase
+  statusServerStop();
+  Serial.println("Dashboard password set");
+}
+
+// One complete line, without its line ending
+static void runCommand(char* buf, size_t rawLen) {
+  StrView raw(buf, rawLen);
+  if (raw.substr(0, 19) == "dashboard password ") {
+    setDashboardPassword(buf + 19, rawLen - 19);
+    return;
+  }
+
+  size_t len = rawLen;
+  while (len > 0 && buf[len - 1] == ' ') len--;
+  buf[len] = '\0';
+  StrView line(buf, len);
+  
+  if (line == "history") {
+    surveyExport(Serial, nullptr);
+  } else if (line == "history erase") {
+    surveyErase();
+    Serial.println("History erased");
+  } else if (line == "history usage") {
+    Serial.printf("History: %lu / %lu bytes\n",
+                  (unsigned long)surveyUsedBytes(), (unsigned long)surveyCapacityBytes());
+  } else if (line.substr(0, 8) == "history ") {
+    uint8_t mac[6];
+    parseMacAddress(buf + 8, mac);
+    surveyExport(Serial, mac);
+  } else if (line == "heap") {
+    printHeapReport(Serial);
+  } else if (line == "trace") {
+    printTrace(Serial);
+  } else if (line == "trace clear") {
+    clearTrace();
+  } else if (line == "dashboard on") {
+    statusServerEnabled = true;
+    saveSettings();
+    if (dashboardPassword.empty()) {
+      Serial.println("Set a password first: dashboard password <pw>");
+    }
+  } else if (line == "dashboard off") {
+    statusServerEnabled = false;
+    saveSettings();
+  } else if (line == "stats") {
+    printCaptureStats(Serial);
+  } else if (line == "links") {
+    exportLinks(Serial);
+  } else if (line == "boot") {
+    printBootReport(Serial);
+  } else if (line == "dashboard") {
+    printStatusReport(Serial);
+  } else if (line.substr(0, 7) == "replay ") {
+    replayTrace(buf + 7, Serial);
+  } else if (line.length() > 0) {
+    Serial.println("Commands: history [bssid|usage|erase], heap, trace [clear], replay <UDLRBH...>, dashboard [on|off|password <pw>], stats, links, boot");
+  }
+}
+
+// Line-based commands on the USB serial port, mainly for exporting data.
+// Bytes are collected as they arrive so a partial line never stalls the
+// UI loop.
+void handleSerialCommands() {
+  static char buf[SERIAL_LINE_LEN];
+  static size_t len = 0;
+  static bool overflow = false;
+
+  while (Serial.available()) {
+    char c = Serial.read();
+    if (c == '\r') continue;
+    if (c != '\n') {
+      if (len < sizeof(buf) - 1) {
+        buf[len++] = c;
+      } else {
+        overflow = true;
+      }
+      continue;
+    }
+
+    if (overflow) {
+      Serial.println("Line too long");
+    } else {
+      buf[len] = '\0';
+      runCommand(buf, len);
+    }
+    len = 0;
+    overflow = false;
+    return;  // one command per loop pass
+  }
+}
@@ -0,0 +1,8 @@
+#ifndef SERIAL_COMMANDS_H
+#define SERIAL_COMMANDS_H
+
+#include "../core/globals.h"
+
+void handleSerialCommands();
+
+#endif
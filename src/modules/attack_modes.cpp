@@ -1,7 +1,19 @@
 #include "attack_modes.h"
 #include "../output/lcd_handler.h"
 #include "packet_analyzer.h"
+#include "beacon_analyzer.h"
+#include "link_analyzer.h"
 #include "web_servers.h"
+#include "status_server.h"
+#include "wifi_scanner.h"
+#include "settings.h"
+#include "survey_history.h"
+
+// Target beacon anomalies already alerted on, and when the alert went up
+#define SPOOF_ALERT_HOLD 10000
+static uint8_t shownFlags = 0;
+static unsigned long alertShownAt = 0;
+static bool alertShowing = false;
 
 void enterPSMode() {
   if (selectedNetwork == -1) {
@@ -9,27 +21,41 @@ void enterPSMode() {
     lcd.print("No network");
     lcd.setCursor(0, 1);
     lcd.print("selected!");
-    delay(2000);
+    uiPause(2000);
     showAttackMenu();
     return;
   }
   
   // Set up promiscuous mode for packet sniffing
-  WiFiNetwork net = networks[selectedNetwork];
-  parseMacAddress(net.bssid, targetBSSID);
+  const WiFiNetwork& net = networks[selectedNetwork];
+  parseMacAddress(net.bssid.c_str(), targetBSSID);
   
+  surveyCancelScan();
+  wifiBegin();
   esp_wifi_set_promiscuous(false);
+  
+  // Initialize monitoring while the callback is off
+  resetCaptureStats();
+  resetBeaconTracks();
+  shownFlags = 0;
+  alertShowing = false;
+  resetLinks();
+  
   esp_wifi_set_promiscuous_rx_cb(&promisc_cb);
   esp_wifi_set_promiscuous(true);
-  esp_wifi_set_channel(net.channel, WIFI_SECOND_CHAN_NONE);
-  
-  // Initialize monitoring
-  packetCount = 0;
-  lastPacketReset = millis();
-  packetLogs.clear();
-  httpCount = dnsCount = arpCount = tcpCount = udpCount = 0;
+  if (esp_wifi_set_channel(net.channel, WIFI_SECOND_CHAN_NONE) != ESP_OK) {
+    // Sniffing on whatever channel the radio is on would log the wrong BSS
+    esp_wifi_set_promiscuous(false);
+    currentState = ATTACK_MENU;
+    lcd.clear();
+    lcd.print("Channel failed!");
+    uiPause(2000);
+    showAttackMenu();
+    return;
+  }
   
   currentState = PS_MODE;
+  saveResumeMode(PS_MODE);
   lcd.clear();
   lcd.print("PS Mode - Sniffing");
   lcd.setCursor(0, 1);
@@ -38,14 +64,16 @@ void enterPSMode() {
 
 void enterMITMMode() {
   // Create a fake "Free WiFi" network
+  surveyCancelScan();
+  statusServerStop();
   WiFi.softAPdisconnect(true);
   WiFi.mode(WIFI_AP);
   
-  String evilSSID = "Free_Public_WiFi";
+  const char* evilSSID = "Free_Public_WiFi";
   if (!WiFi.softAP(evilSSID)) {
     lcd.clear();
     lcd.print("AP Setup Failed!");
-    delay(2000);
+    uiPause(2000);
     showAttackMenu();
     return;
   }
@@ -61,22 +89,25 @@ void enterMITMMode() {
   
   currentState = MITM_MODE;
   lcd.clear();
-  lcd.print("MITM: " + evilSSID);
+  lcd.print("MITM: ");
+  lcd.print(evilSSID);
   lcd.setCursor(0, 1);
   lcd.print("Clients: 0");
 }
 
 void enterAPMode() {
   // Create a weak access point with WEP encryption (weak security)
+  surveyCancelScan();
+  statusServerStop();
   WiFi.softAPdisconnect(true);
   WiFi.mode(WIFI_AP);
   
   // Create a weakly configured network
-  String weakSSID = "Weak_Open_WiFi";
+  const char* weakSSID = "Weak_Open_WiFi";
   if (!WiFi.softAP(weakSSID)) {
     lcd.clear();
     lcd.print("AP Setup Failed!");
-    delay(2000);
+    uiPause(2000);
     showAttackMenu();
     return;
   }
@@ -90,7 +121,8 @@ void enterAPMode() {
   apPage = 0;
   currentState = AP_MODE;
   lcd.clear();
-  lcd.print("AP: " + weakSSID);
+  lcd.print("AP: ");
+  lcd.print(weakSSID);
   lcd.setCursor(0, 1);
   lcd.print("Clients: 0");
 }
@@ -101,8 +133,30 @@ void updatePSMode() {
   if (millis() - lastUpdate > 1000) {
     lastUpdate = millis();
     
+    // One consistent copy of the capture counters for this refresh
+    CaptureStats stats = readCaptureStats();
+    
+    // Flag new beacon anomalies on the target straight away and keep the
+    // alert up for SPOOF_ALERT_HOLD ms instead of one refresh
+    uint8_t targetFlags = stats.targetFlags;
+    if (targetFlags & ~shownFlags) {
+      alertShowing = true;
+      alertShownAt = millis();
+      lcd.clear();
+      lcd.print("SPOOF SUSPECT!");
+      lcd.setCursor(0, 1);
+      lcd.print(beaconAnomalyString(targetFlags).c_str());
+    }
+    shownFlags = targetFlags;
+    if (alertShowing) {
+      if (millis() - alertShownAt < SPOOF_ALERT_HOLD) return;
+      alertShowing = false;
+      lcd.clear();
+    }
+    
     lcd.setCursor(6, 1);
-    lcd.print(String(packetCount) + " ");
+    lcd.print(stats.framesPerWindow);
+    lcd.print(" ");
     
     // Show protocol breakdown occasionally
     static int displayMode = 0;
@@ -110,27 +164,64 @@ void updatePSMode() {
       lcd.clear();
       switch(displayMode) {
         case 0:
-          lcd.print("HTTP: " + String(httpCount));
+          lcd.print("HTTP: ");
+          lcd.print(stats.http);
           lcd.setCursor(0, 1);
-          lcd.print("DNS: " + String(dnsCount));
+          lcd.print("DNS: ");
+          lcd.print(stats.dns);
           break;
         case 1:
-          lcd.print("TCP: " + String(tcpCount));
+          lcd.print("TCP: ");
+          lcd.print(stats.tcp);
           lcd.setCursor(0, 1);
-          lcd.print("UDP: " + String(udpCount));
+          lcd.print("UDP: ");
+          lcd.print(stats.udp);
           break;
         case 2:
-          lcd.print("ARP: " + String(arpCount));
+          lcd.print("ARP: ");
+          lcd.print(stats.arp);
           lcd.setCursor(0, 1);
-          lcd.print("Total: " + String(packetCount));
+          lcd.print("Total: ");
+          lcd.print(stats.frames);
+          break;
+        case 3:
+          if (stats.targetSeen) {
+            lcd.print("Bcn J:");
+            lcd.print(stats.targetJitterUs);
+            lcd.print("us");
+            lcd.setCursor(0, 1);
+            lcd.print("D:");
+            lcd.print(stats.targetDriftPpm);
+            lcd.print(" ");
+            lcd.print(beaconAnomalyString(stats.targetFlags).c_str());
+          } else {
+            lcd.print("No beacons yet");
+            lcd.setCursor(0, 1);
+            lcd.print("Suspect APs: ");
+            lcd.print(stats.suspectAps);
+          }
+          break;
+        case 4:
+          // Link with the most loss and retries in the target BSS
+          if (stats.hasLink) {
+            lcd.printf("%02x:%02x>%02x:%02x %s", stats.linkTa[4], stats.linkTa[5],
+                       stats.linkRa[4], stats.linkRa[5], linkRateLabel(stats.linkRate).c_str());
+            lcd.setCursor(0, 1);
+            lcd.printf("L%u.%u%% R%u.%u%%", stats.linkLoss / 10, stats.linkLoss % 10,
+                       stats.linkRetry / 10, stats.linkRetry % 10);
+          } else {
+            lcd.print("No links yet");
+          }
           break;
       }
-      displayMode = (displayMode + 1) % 3;
+      displayMode = (displayMode + 1) % 5;
     } else {
       lcd.setCursor(0, 0);
       lcd.print("PS Mode - Sniffing");
       lcd.setCursor(0, 1);
-      lcd.print("Pkts: " + String(packetCount) + " ");
+      lcd.print("Pkts: ");
+      lcd.print(stats.framesPerWindow);
+      lcd.print(" ");
     }
   }
 }
@@ -148,7 +239,8 @@ void updateMITMMode() {
       lcd.clear();
       lcd.print("MITM: Free WiFi");
       lcd.setCursor(0, 1);
-      lcd.print("Clients: " + String(mitmClientCount));
+      lcd.print("Clients: ");
+      lcd.print(mitmClientCount);
     } else {
       // Show credential logs page
       lcd.clear();
@@ -158,9 +250,7 @@ void updateMITMMode() {
       if (mitmCredentials.empty()) {
         lcd.print("No credentials");
       } else {
-        String latestCred = mitmCredentials.back();
-        int maxLen = min(16, (int)latestCred.length());
-        lcd.print(latestCred.substring(0, maxLen));
+        lcd.print(mitmCredentials.back().view().substr(0, 16));
       }
     }
   }
@@ -177,11 +267,9 @@ void updateAPMode() {
       apClientCount = newClientCount;
       
       // Log connection changes
-      String log = "Clients: " + String(apClientCount);
-      apLogs.push_back(log);
-      if (apLogs.size() > 20) {
-        apLogs.erase(apLogs.begin());
-      }
+      FixedString<LOG_ENTRY_LEN> log;
+      log.appendf("Clients: %u", apClientCount);
+      apLogs.push(log.c_str());
     }
     
     if (apPage == 0) {
@@ -189,7 +277,8 @@ void updateAPMode() {
       lcd.clear();
       lcd.print("AP: Weak WiFi");
       lcd.setCursor(0, 1);
-      lcd.print("Clients: " + String(apClientCount));
+      lcd.print("Clients: ");
+      lcd.print(apClientCount);
     } else {
       // Show activity logs page
       lcd.clear();
@@ -199,9 +288,7 @@ void updateAPMode() {
       if (apLogs.empty()) {
         lcd.print("No activity");
       } else {
-        String latestLog = apLogs.back();
-        int maxLen = min(16, (int)latestLog.length());
-        lcd.print(latestLog.substring(0, maxLen));
+        lcd.print(apLogs.back().view().substr(0, 16));
       }
     }
   }
@@ -0,0 +1,179 @@
+#include "beacon_analyzer.h"
+
+static BeaconTrack* lookupTrack(const uint8_t* bssid, uint32_t now) {
+  BeaconTrack* oldest = &beaconTracks[0];
+  for (int i = 0; i < MAX_BEACON_TRACKS; i++) {
+    BeaconTrack* t = &beaconTracks[i];
+    if (t->used && memcmp(t->bssid, bssid, 6) == 0) return t;
+    if (!t->used) {
+      oldest = t;
+    } else if (oldest->used && (int32_t)(t->lastSeen - oldest->lastSeen) < 0) {
+      oldest = t;
+    }
+  }
+
+  // New BSSID: take a free slot or recycle the quietest track
+  memset(oldest, 0, sizeof(BeaconTrack));
+  memcpy(oldest->bssid, bssid, 6);
+  oldest->used = true;
+  oldest->lastSeen = now;
+  return oldest;
+}
+
+// Drop the window statistics but keep the anomaly counters
+static void restartWindow(BeaconTrack* t) {
+  t->head = 0;
+  t->count = 0;
+  t->deltas = 0;
+  t->sumDelta = 0;
+  t->sumJitter = 0;
+  t->sumDrift = 0;
+}
+
+void analyzeBeacon(const wifi_promiscuous_pkt_t* pkt, const FrameInfo& info) {
+  if (info.type != FRAME_TYPE_MGMT || info.subtype != MGMT_SUBTYPE_BEACON || !info.hasBeaconBody) {
+    return;
+  }
+
+  const uint8_t* bssid = info.bssid;
+  uint32_t arrival = pkt->rx_ctrl.timestamp;
+  uint16_t seq = info.seq;
+  uint64_t tsf = info.tsf;
+
+  BeaconTrack* t = lookupTrack(bssid, arrival);
+  t->intervalTU = info.intervalTU;
+  t->lastSeen = arrival;
+  t->beacons++;
+
+  int32_t delta = 0;
+  int32_t jitter = 0;
+  int32_t drift = 0;
+
+  if (t->count > 0) {
+    int last = (t->head + BEACON_HISTORY - 1) % BEACON_HISTORY;
+    uint16_t seqStep = (seq - t->seq[last]) & 0x0FFF;
+
+    if (tsf <= t->tsf[last]) {
+      // TSF never goes backwards on a real AP
+      t->tsfResets++;
+      t->flags |= BEACON_TSF_RESET;
+      restartWindow(t);
+    } else {
+      if (seqStep == 0 || seqStep > 2048) {
+        // Duplicate or backwards sequence number: a second transmitter
+        t->seqAnomalies++;
+        t->flags |= BEACON_SEQ_ORDER;
+      }
+
+      delta = arrival - t->arrival[last];
+      int64_t tsfDelta = (int64_t)(tsf - t->tsf[last]);
+      drift = (int32_t)(tsfDelta - delta);
+
+      // Deviation from the nearest multiple of the advertised interval,
+      // so missed beacons do not count as jitter
+      int32_t period = t->intervalTU * 1024;
+      if (period > 0) {
+        int32_t rem = delta % period;
+        jitter = (rem > period / 2) ? period - rem : rem;
+      }
+    }
+  }
+
+  // Evict the oldest sample once the window is full
+  if (t->count == BEACON_HISTORY) {
+    int oldest = t->head;
+    if (t->delta[oldest] > 0) {
+      t->sumDelta -= t->delta[oldest];
+      t->sumJitter -= t->jitter[oldest];
+      t->sumDrift -= t->drift[oldest];
+      t->deltas--;
+    }
+  } else {
+    t->count++;
+  }
+
+  t->arrival[t->head] = arrival;
+  t->tsf[t->head] = tsf;
+  t->seq[t->head] = seq;
+  t->delta[t->head] = delta;
+  t->jitter[t->head] = jitter;
+  t->drift[t->head] = drift;
+  if (delta > 0) {
+    t->sumDelta += delta;
+    t->sumJitter += jitter;
+    t->sumDrift += drift;
+    t->deltas++;
+  }
+  t->head = (t->head + 1) % BEACON_HISTORY;
+
+  // Judge timing on every beacon once the window holds a full history
+  if (t->count == BEACON_HISTORY) {
+    if (beaconJitterUs(*t) > BEACON_JITTER_LIMIT_US) {
+      t->jitterAnomalies++;
+      t->flags |= BEACON_JITTER;
+    }
+    int32_t ppm = beaconDriftPpm(*t);
+    if (ppm > BEACON_DRIFT_LIMIT_PPM || ppm < -BEACON_DRIFT_LIMIT_PPM) {
+      t->driftAnomalies++;
+      t->flags |= BEACON_DRIFT;
+    }
+  }
+}
+
+void resetBeaconTracks() {
+  memset(beaconTracks, 0, sizeof(beaconTracks));
+}
+
+const BeaconTrack* findBeaconTrack(const uint8_t* bssid) {
+  for (int i = 0; i < MAX_BEACON_TRACKS; i++) {
+    if (beaconTracks[i].used && memcmp(beaconTracks[i].bssid, bssid, 6) == 0) {
+      return &beaconTracks[i];
+    }
+  }
+  return nullptr;
+}
+
+// Mean deviation from the beacon interval over the window, in microseconds
+int32_t beaconJitterUs(const BeaconTrack& track) {
+  if (track.deltas == 0) return 0;
+  return track.sumJitter / track.deltas;
+}
+
+// TSF clock drift relative to our receive clock, in parts per million
+int32_t beaconDriftPpm(const BeaconTrack& track) {
+  if (track.sumDelta == 0) return 0;
+  return (int32_t)(track.sumDrift * 1000000LL / (int64_t)track.sumDelta);
+}
+
+int countAnomalousBeacons() {
+  int count = 0;
+  for (int i = 0; i < MAX_BEACON_TRACKS; i++) {
+    if (beaconTracks[i].used && beaconTracks[i].flags) count++;
+  }
+  return count;
+}
+
+// Copies up to max flagged tracks into rows; returns how many
+int flaggedBeacons(AlertRow* rows, int max) {
+  int count = 0;
+  for (int i = 0; i < MAX_BEACON_TRACKS && count < max; i++) {
+    const BeaconTrack& t = beaconTracks[i];
+    if (!t.used || !t.flags) continue;
+    AlertRow& row = rows[count++];
+    memcpy(row.bssid, t.bssid, 6);
+    row.flags = t.flags;
+    row.jitterUs = beaconJitterUs(t);
+    row.driftPpm = beaconDriftPpm(t);
+  }
+  return count;
+}
+
+FixedString<17> beaconAnomalyString(uint8_t flags) {
+  FixedString<17> s;
+  if (!flags) return s.assign("OK");
+  if (flags & BEACON_TSF_RESET) s += "TSF ";
+  if (flags & BEACON_SEQ_ORDER) s += "SEQ ";
+  if (flags & BEACON_JITTER) s += "JIT ";
+  if (flags & BEACON_DRIFT) s += "DRF ";
+  return s;
+}
@@ -0,0 +1,16 @@
+#ifndef BEACON_ANALYZER_H
+#define BEACON_ANALYZER_H
+
+#include "../core/globals.h"
+#include "../core/frame_decoder.h"
+
+void analyzeBeacon(const wifi_promiscuous_pkt_t* pkt, const FrameInfo& info);
+void resetBeaconTracks();
+const BeaconTrack* findBeaconTrack(const uint8_t* bssid);
+int32_t beaconJitterUs(const BeaconTrack& track);
+int32_t beaconDriftPpm(const BeaconTrack& track);
+int countAnomalousBeacons();
+int flaggedBeacons(AlertRow* rows, int max);
+FixedString<17> beaconAnomalyString(uint8_t flags);
+
+#endif
@@ -0,0 +1,66 @@
+#include "heap_monitor.h"
+#include <esp_heap_caps.h>
+
+static uint32_t baselineBlocks = 0;
+static unsigned long lastHeapSample = 0;
+
+static void onAllocFailed(size_t size, uint32_t caps, const char* functionName) {
+  heapStats.failedAllocs++;
+  heapStats.lastFailedSize = size;
+}
+
+void heapMonitorBegin() {
+  heap_caps_register_failed_alloc_callback(onAllocFailed);
+  sampleHeap();
+}
+
+void sampleHeap() {
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+
+  if (heapStats.samples == 0) {
+    baselineBlocks = info.allocated_blocks;
+    heapStats.worstLargestBlock = info.largest_free_block;
+  }
+
+  heapStats.freeBytes = info.total_free_bytes;
+  heapStats.minFreeBytes = info.minimum_free_bytes;
+  heapStats.largestBlock = info.largest_free_block;
+  heapStats.allocatedBlocks = info.allocated_blocks;
+  heapStats.freeBlocks = info.free_blocks;
+  heapStats.blockGrowth = (int32_t)info.allocated_blocks - (int32_t)baselineBlocks;
+
+  // Share of free memory that is not usable as one contiguous block
+  heapStats.fragmentation = info.total_free_bytes
+    ? 100 - (uint8_t)((uint64_t)info.largest_free_block * 100 / info.total_free_bytes)
+    : 0;
+
+  if (info.largest_free_block < heapStats.worstLargestBlock) {
+    heapStats.worstLargestBlock = info.largest_free_block;
+  }
+  heapStats.samples++;
+}
+
+// Returns true when a new sample was taken
+bool updateHeapMonitor() {
+  if (millis() - lastHeapSample < HEAP_SAMPLE_INTERVAL) return false;
+  lastHeapSample = millis();
+  sampleHeap();
+  return true;
+}
+
+void printHeapReport(Print& out) {
+  sampleHeap();
+  unsigned long up = millis() / 1000;
+  out.printf("Uptime: %luh%02lum%02lus\n", up / 3600, (up / 60) % 60, up % 60);
+  out.printf("Free heap: %lu (min %lu)\n",
+             (unsigned long)heapStats.freeBytes, (unsigned long)heapStats.minFreeBytes);
+  out.printf("Largest block: %lu (worst %lu), fragmentation %u%%\n",
+             (unsigned long)heapStats.largestBlock, (unsigned long)heapStats.worstLargestBlock,
+             heapStats.fragmentation);
+  out.printf("Blocks: %lu allocated (%+ld since boot), %lu free\n",
+             (unsigned long)heapStats.allocatedBlocks, (long)heapStats.blockGrowth,
+             (unsigned long)heapStats.freeBlocks);
+  out.printf("Failed allocations: %lu (last %lu bytes)\n",
+             (unsigned long)heapStats.failedAllocs, (unsigned long)heapStats.lastFailedSize);
+}
@@ -0,0 +1,11 @@
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include "../core/globals.h"
+
+void heapMonitorBegin();
+void sampleHeap();
+bool updateHeapMonitor();
+void printHeapReport(Print& out);
+
+#endif
@@ -0,0 +1,217 @@
+#include "link_analyzer.h"
+#include "packet_analyzer.h"
+
+// Loss and retransmission per (transmitter, receiver) pair in the target
+// BSS. Loss comes from gaps in QoS sequence numbers, retransmission from
+// the retry bit; both are kept as totals and as a running average.
+
+// rx_ctrl.rate codes for 802.11b/g frames, in 100 kbps
+static const uint16_t LEGACY_RATES[16] = {
+  10, 20, 55, 110, 0, 20, 55, 110, 480, 240, 120, 60, 540, 360, 180, 90
+};
+
+// HT MCS 0-7 for one stream, 20 MHz and long guard interval, in 100 kbps
+static const uint16_t HT_RATES[8] = { 65, 130, 195, 260, 390, 520, 585, 650 };
+
+static LinkStats* lookupLink(const uint8_t* ta, const uint8_t* ra, uint32_t now) {
+  LinkStats* oldest = &links[0];
+  for (int i = 0; i < MAX_LINKS; i++) {
+    LinkStats* l = &links[i];
+    if (l->used && memcmp(l->ta, ta, 6) == 0 && memcmp(l->ra, ra, 6) == 0) return l;
+    if (!l->used) {
+      oldest = l;
+    } else if (oldest->used && (int32_t)(l->lastSeen - oldest->lastSeen) < 0) {
+      oldest = l;
+    }
+  }
+
+  // New link: take a free slot or recycle the quietest link
+  memset(oldest, 0, sizeof(LinkStats));
+  memcpy(oldest->ta, ta, 6);
+  memcpy(oldest->ra, ra, 6);
+  oldest->used = true;
+  oldest->lastSeen = now;
+  return oldest;
+}
+
+static void addSample(int32_t& ewma, bool hit) {
+  ewma += ((hit ? 65536 : 0) - ewma) >> LINK_EWMA_SHIFT;
+}
+
+void analyzeLink(const wifi_promiscuous_pkt_t* pkt, const FrameInfo& info) {
+  if (info.type != FRAME_TYPE_DATA || !info.addr2 || !info.bssid) return;
+  if (memcmp(info.bssid, targetBSSID, 6) != 0) return;
+  // Later fragments repeat the sequence number of the first
+  if (info.frag != 0) return;
+
+  LinkStats* l = lookupLink(info.addr2, info.addr1, pkt->rx_ctrl.timestamp);
+  l->lastSeen = pkt->rx_ctrl.timestamp;
+  l->frames++;
+  if (info.retry) l->retries++;
+  addSample(l->retryEwma, info.retry);
+
+  uint16_t rate = phyRate100k(pkt->rx_ctrl);
+  int bucket = 0;
+  while (bucket < LINK_RATE_BUCKETS - 1 && rate > LINK_RATE_LIMITS[bucket] * 10) bucket++;
+  l->rates[bucket]++;
+
+  if (!info.qos) return;
+  uint8_t tid = info.tid & 0x07;
+  uint8_t bit = 1 << tid;
+
+  if (l->seqValid & bit) {
+    uint16_t gap = (info.seq - l->lastSeq[tid]) & 0x0FFF;
+    if (gap == 0) {
+      // Seen before: the frame arrived but its ACK did not
+      l->duplicates++;
+      return;
+    }
+    if (gap <= LINK_MAX_GAP) {
+      l->lost += gap - 1;
+      for (int i = 1; i < gap; i++) addSample(l->lossEwma, true);
+      addSample(l->lossEwma, false);
+    } else {
+      // Reordering, power save or a burst we missed while busy
+      l->resyncs++;
+    }
+  }
+  l->lastSeq[tid] = info.seq;
+  l->seqValid |= bit;
+}
+
+void resetLinks() {
+  memset(links, 0, sizeof(links));
+}
+
+// Links with enough traffic rank by recent loss plus retries; the rest
+// come after them, busiest first
+static bool worseThan(const LinkStats& a, const LinkStats& b) {
+  bool aRated = a.frames >= 32;
+  bool bRated = b.frames >= 32;
+  if (aRated != bRated) return aRated;
+  if (aRated && a.lossEwma + a.retryEwma != b.lossEwma + b.retryEwma) {
+    return a.lossEwma + a.retryEwma > b.lossEwma + b.retryEwma;
+  }
+  return a.frames > b.frames;
+}
+
+// Link with the highest recent loss, among links with some traffic
+const LinkStats* worstLink() {
+  const LinkStats* worst = nullptr;
+  for (int i = 0; i < MAX_LINKS; i++) {
+    const LinkStats& l = links[i];
+    if (!l.used || l.frames < 32) continue;
+    if (!worst || l.lossEwma + l.retryEwma > worst->lossEwma + worst->retryEwma) {
+      worst = &l;
+    }
+  }
+  return worst;
+}
+
+// PHY rate of a received frame, in 100 kbps
+uint16_t phyRate100k(const wifi_pkt_rx_ctrl_t& rx) {
+  if (rx.sig_mode == 0) return LEGACY_RATES[rx.rate & 0x0F];
+  uint32_t rate = HT_RATES[rx.mcs & 0x07] * ((rx.mcs >> 3) + 1);
+  if (rx.cwb) rate = rate * 27 / 13;   // 40 MHz: 108 data subcarriers vs 52
+  if (rx.sgi) rate = rate * 10 / 9;
+  return rate;
+}
+
+// Loss over the whole run, in tenths of a percent
+uint16_t linkLossPermille(const LinkStats& link) {
+  uint32_t sent = link.frames - link.duplicates + link.lost;
+  if (sent == 0) return 0;
+  return (uint64_t)link.lost * 1000 / sent;
+}
+
+// Share of frames that were retransmissions, in tenths of a percent
+uint16_t linkRetryPermille(const LinkStats& link) {
+  if (link.frames == 0) return 0;
+  return (uint64_t)link.retries * 1000 / link.frames;
+}
+
+// Upper limit in Mbps of the most used rate bucket
+uint8_t linkTypicalRate(const LinkStats& link) {
+  int best = 0;
+  for (int i = 1; i < LINK_RATE_BUCKETS; i++) {
+    if (link.rates[i] > link.rates[best]) best = i;
+  }
+  return LINK_RATE_LIMITS[best];
+}
+
+// Typical rate for display, e.g. "54M"; the top bucket has no real upper
+// limit, so it reads ">72M"
+FixedString<6> linkRateLabel(uint8_t rate) {
+  FixedString<6> label;
+  if (rate == LINK_RATE_LIMITS[LINK_RATE_BUCKETS - 1]) {
+    label.appendf(">%uM", LINK_RATE_LIMITS[LINK_RATE_BUCKETS - 2]);
+  } else {
+    label.appendf("%uM", rate);
+  }
+  return label;
+}
+
+static uint16_t ewmaPermille(int32_t ewma) {
+  return (uint32_t)ewma * 1000 >> 16;
+}
+
+// Copies the worst max links into rows, worst first; returns how many.
+// Runs in the capture callback, so it sorts indexes, not the table.
+int topLinks(LinkRow* rows, int max, int& tracked) {
+  uint8_t order[MAX_LINKS];
+  tracked = 0;
+  for (int i = 0; i < MAX_LINKS; i++) {
+    if (!links[i].used) continue;
+    int pos = tracked++;
+    while (pos > 0 && worseThan(links[i], links[order[pos - 1]])) {
+      order[pos] = order[pos - 1];
+      pos--;
+    }
+    order[pos] = i;
+  }
+
+  int count = tracked < max ? tracked : max;
+  for (int i = 0; i < count; i++) {
+    const LinkStats& l = links[order[i]];
+    LinkRow& row = rows[i];
+    memcpy(row.ta, l.ta, 6);
+    memcpy(row.ra, l.ra, 6);
+    row.frames = l.frames;
+    row.retries = l.retries;
+    row.lost = l.lost;
+    row.duplicates = l.duplicates;
+    row.resyncs = l.resyncs;
+    row.lossPermille = linkLossPermille(l);
+    row.retryPermille = linkRetryPermille(l);
+    row.recentLossPermille = ewmaPermille(l.lossEwma);
+    row.recentRetryPermille = ewmaPermille(l.retryEwma);
+    memcpy(row.rates, l.rates, sizeof(row.rates));
+  }
+  return count;
+}
+
+// Exports the published summary, not the live table the callback writes
+void exportLinks(Print& out) {
+  TableSummary summary = tableSnapshot.read();
+  out.print("ta,ra,frames,retries,lost,duplicates,resyncs,loss_pm,retry_pm,recent_loss_pm,recent_retry_pm");
+  for (int i = 0; i < LINK_RATE_BUCKETS - 1; i++) {
+    out.printf(",rate_le%u", LINK_RATE_LIMITS[i]);
+  }
+  out.printf(",rate_gt%u\n", LINK_RATE_LIMITS[LINK_RATE_BUCKETS - 2]);
+
+  for (int i = 0; i < summary.linkCount; i++) {
+    const LinkRow& l = summary.links[i];
+    out.printf("%s,%s,%lu,%lu,%lu,%lu,%lu,%u,%u,%u,%u",
+               macToString(l.ta).c_str(), macToString(l.ra).c_str(),
+               (unsigned long)l.frames, (unsigned long)l.retries, (unsigned long)l.lost,
+               (unsigned long)l.duplicates, (unsigned long)l.resyncs,
+               l.lossPermille, l.retryPermille, l.recentLossPermille, l.recentRetryPermille);
+    for (int b = 0; b < LINK_RATE_BUCKETS; b++) {
+      out.printf(",%lu", (unsigned long)l.rates[b]);
+    }
+    out.println();
+  }
+  if (summary.linksTracked > summary.linkCount) {
+    out.printf("# %u more links not shown\n", summary.linksTracked - summary.linkCount);
+  }
+}
@@ -0,0 +1,18 @@
+#ifndef LINK_ANALYZER_H
+#define LINK_ANALYZER_H
+
+#include "../core/globals.h"
+#include "../core/frame_decoder.h"
+
+void analyzeLink(const wifi_promiscuous_pkt_t* pkt, const FrameInfo& info);
+void resetLinks();
+const LinkStats* worstLink();
+uint16_t phyRate100k(const wifi_pkt_rx_ctrl_t& rx);
+uint16_t linkLossPermille(const LinkStats& link);
+uint16_t linkRetryPermille(const LinkStats& link);
+uint8_t linkTypicalRate(const LinkStats& link);
+FixedString<6> linkRateLabel(uint8_t rate);
+int topLinks(LinkRow* rows, int max, int& tracked);
+void exportLinks(Print& out);
+
+#endif
@@ -1,56 +1,51 @@
 #include "packet_analyzer.h"
+#include "beacon_analyzer.h"
+#include "link_analyzer.h"
+
+static void publishPacketLogs();
 
 // Enhanced packet analysis function
-void analyzePacket(const wifi_promiscuous_pkt_t* pkt) {
-  wifi_pkt_rx_ctrl_t ctrl = (wifi_pkt_rx_ctrl_t)pkt->rx_ctrl;
+void analyzePacket(const wifi_promiscuous_pkt_t* pkt, const FrameInfo& info) {
   const uint8_t* frame = pkt->payload;
   
-  // Extract MAC addresses
-  const uint8_t* macTo = frame + 4;
-  const uint8_t* macFrom = frame + 10;
-  
-  // Check packet type (first byte of frame control field)
-  uint8_t frameControl = frame[0];
-  uint8_t frameType = (frameControl & 0x0C) >> 2;
-  uint8_t frameSubtype = (frameControl & 0xF0) >> 4;
+  // Transmitter address; CTS and ACK only carry the receiver
+  const uint8_t* macFrom = info.addr2 ? info.addr2 : info.addr1;
   
-  String protocol = getProtocolName(frameType);
-  String macStr = macToString(macFrom);
+  const char* protocol = getProtocolName(info.type);
   
   // Count protocols
-  if (protocol == "HTTP") httpCount++;
-  else if (protocol == "DNS") dnsCount++;
-  else if (protocol == "ARP") arpCount++;
-  else if (protocol == "TCP") tcpCount++;
-  else if (protocol == "UDP") udpCount++;
+  if (strcmp(protocol, "HTTP") == 0) httpCount++;
+  else if (strcmp(protocol, "DNS") == 0) dnsCount++;
+  else if (strcmp(protocol, "ARP") == 0) arpCount++;
+  else if (strcmp(protocol, "TCP") == 0) tcpCount++;
+  else if (strcmp(protocol, "UDP") == 0) udpCount++;
   
   // Log interesting packets
   if (packetLogs.size() < MAX_PACKET_LOGS && millis() - lastPacketLog > 2000) {
     lastPacketLog = millis();
     
-    String log = protocol + " from " + macStr.substring(9);
-    if (protocol == "HTTP") {
+    FixedString<18> macStr = macToString(macFrom);
+    FixedString<LOG_ENTRY_LEN> log;
+    log.appendf("%s from %s", protocol, macStr.c_str() + 9);
+    if (strcmp(protocol, "HTTP") == 0) {
       // Try to extract HTTP host
       for (int i = 0; i < pkt->rx_ctrl.sig_len - 40; i++) {
         if (frame[i] == 'H' && frame[i+1] == 'o' && frame[i+2] == 's' && frame[i+3] == 't' && frame[i+4] == ':') {
-          String host = "";
+          log = "HTTP to ";
           for (int j = i+5; j < pkt->rx_ctrl.sig_len && frame[j] != '\r'; j++) {
-            host += (char)frame[j];
+            log += (char)frame[j];
           }
-          log = "HTTP to " + host;
           break;
         }
       }
     }
     
-    packetLogs.push_back(log);
-    if (packetLogs.size() > MAX_PACKET_LOGS) {
-      packetLogs.erase(packetLogs.begin());
-    }
+    packetLogs.push(log.c_str());
+    publishPacketLogs();
   }
 }
 
-String getProtocolName(uint8_t type) {
+const char* getProtocolName(uint8_t type) {
   switch (type) {
     case 0: return "Management";
     case 1: return "Control";
@@ -59,11 +54,141 @@ String getProtocolName(uint8_t type) {
   }
 }
 
-String macToString(const uint8_t* mac) {
-  char buf[20];
-  snprintf(buf, sizeof(buf), "%02x:%02x:%02x:%02x:%02x:%02x",
-           mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-  return String(buf);
+FixedString<18> macToString(const uint8_t* mac) {
+  FixedString<18> str;
+  str.appendf("%02x:%02x:%02x:%02x:%02x:%02x",
+              mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  return str;
+}
+
+// Capture-side totals; only the callback touches these once sniffing runs
+static uint32_t capturedFrames = 0;
+static uint32_t lastWindowFrames = 0;
+static unsigned long lastPublish = 0;
+
+// Flagged beacons and the worst links, copied out of the live tables.
+// Static: too large for the Wi-Fi task stack, and only this callback
+// writes it.
+static void publishTableSummary() {
+  static TableSummary summary;
+  int tracked = 0;
+  summary.alertCount = flaggedBeacons(summary.alerts, SUMMARY_ALERTS);
+  summary.linkCount = topLinks(summary.links, SUMMARY_LINKS, tracked);
+  summary.linksTracked = tracked;
+  tableSnapshot.publish(summary);
+}
+
+// Static like the table summary: about 1 KB, written only by the callback
+static void publishPacketLogs() {
+  static PacketLogSummary summary;
+  summary.count = packetLogs.size();
+  for (size_t i = 0; i < packetLogs.size(); i++) {
+    summary.entries[i] = packetLogs[i];
+  }
+  packetLogSnapshot.publish(summary);
+}
+
+// Publishes a consistent summary for readers on the other core
+static void publishCaptureStats() {
+  unsigned long now = millis();
+  if (now - lastPacketReset > PACKET_WINDOW) {
+    lastWindowFrames = packetCount;
+    packetCount = 0;
+    lastPacketReset = now;
+  }
+  if (now - lastPublish < CAPTURE_PUBLISH_INTERVAL) return;
+  lastPublish = now;
+  
+  CaptureStats stats = {};
+  stats.publishedAt = now;
+  stats.frames = capturedFrames;
+  stats.framesPerWindow = lastWindowFrames;
+  stats.http = httpCount;
+  stats.dns = dnsCount;
+  stats.arp = arpCount;
+  stats.tcp = tcpCount;
+  stats.udp = udpCount;
+  stats.suspectAps = countAnomalousBeacons();
+  
+  const BeaconTrack* target = findBeaconTrack(targetBSSID);
+  if (target) {
+    stats.targetSeen = true;
+    stats.targetFlags = target->flags;
+    stats.targetJitterUs = beaconJitterUs(*target);
+    stats.targetDriftPpm = beaconDriftPpm(*target);
+  }
+  
+  const LinkStats* link = worstLink();
+  if (link) {
+    stats.hasLink = true;
+    memcpy(stats.linkTa, link->ta, 6);
+    memcpy(stats.linkRa, link->ra, 6);
+    stats.linkRate = linkTypicalRate(*link);
+    stats.linkLoss = linkLossPermille(*link);
+    stats.linkRetry = linkRetryPermille(*link);
+  }
+  
+  captureSnapshot.publish(stats);
+  publishTableSummary();
+}
+
+// Call with the promiscuous callback disabled
+void resetCaptureStats() {
+  packetCount = 0;
+  capturedFrames = 0;
+  lastWindowFrames = 0;
+  httpCount = dnsCount = arpCount = tcpCount = udpCount = 0;
+  packetLogs.clear();
+  lastPacketReset = millis();
+  lastPublish = millis();
+  
+  CaptureStats stats = {};
+  stats.publishedAt = millis();
+  captureSnapshot.publish(stats);
+  tableSnapshot.publish(TableSummary());
+  publishPacketLogs();
+}
+
+// Refills out with the last published packet log; UI core only
+void readPacketLogs(LogList<LOG_ENTRY_LEN>& out) {
+  static PacketLogSummary summary;
+  while (!packetLogSnapshot.tryRead(summary)) {
+  }
+  out.clear();
+  for (uint8_t i = 0; i < summary.count; i++) {
+    out.push(summary.entries[i].c_str());
+  }
+}
+
+// Latest summary; the frame rate reads as zero once frames stop coming
+CaptureStats readCaptureStats() {
+  CaptureStats stats = captureSnapshot.read();
+  if (millis() - stats.publishedAt > 2 * PACKET_WINDOW) {
+    stats.framesPerWindow = 0;
+  }
+  return stats;
+}
+
+void printCaptureStats(Print& out) {
+  CaptureStats stats = readCaptureStats();
+  out.printf("Frames: %lu total, %lu/s (snapshot #%lu, %lu ms old)\n",
+             (unsigned long)stats.frames, (unsigned long)stats.framesPerWindow,
+             (unsigned long)captureSnapshot.version(),
+             (unsigned long)(millis() - stats.publishedAt));
+  out.printf("HTTP %d DNS %d TCP %d UDP %d ARP %d, suspect APs %d\n",
+             stats.http, stats.dns, stats.tcp, stats.udp, stats.arp, stats.suspectAps);
+  if (stats.targetSeen) {
+    out.printf("Target beacons: jitter %ld us, drift %ld ppm, %s\n",
+               (long)stats.targetJitterUs, (long)stats.targetDriftPpm,
+               beaconAnomalyString(stats.targetFlags).c_str());
+  }
+  if (stats.hasLink) {
+    out.printf("Worst link: %s > %s, loss %u.%u%%, retry %u.%u%%, ~%sbps\n",
+               macToString(stats.linkTa).c_str(), macToString(stats.linkRa).c_str(),
+               stats.linkLoss / 10, stats.linkLoss % 10,
+               stats.linkRetry / 10, stats.linkRetry % 10,
+               linkRateLabel(stats.linkRate).c_str());
+  }
 }
 
 // Promiscuous callback for packet monitoring
@@ -72,13 +197,32 @@ void promisc_cb(void* buf, wifi_promiscuous_pkt_type_t type) {
   
   // Always count packets
   packetCount++;
+  capturedFrames++;
+  
+  if (!bootTiming.firstFrame) bootTiming.firstFrame = millis();
+  
+  FrameInfo info;
+  if (!decodeFrame(pkt->payload, pkt->rx_ctrl.sig_len, info)) return;
+  
+  if (!bootTiming.firstCapture && info.bssid && memcmp(info.bssid, targetBSSID, 6) == 0) {
+    bootTiming.firstCapture = millis();
+  }
   
   // Analyze packet contents
-  analyzePacket(pkt);
+  analyzePacket(pkt, info);
+  
+  // Track beacon timing for spoofed AP detection
+  if (type == WIFI_PKT_MGMT) {
+    analyzeBeacon(pkt, info);
+  } else if (type == WIFI_PKT_DATA) {
+    analyzeLink(pkt, info);
+  }
+  
+  publishCaptureStats();
 }
 
-void parseMacAddress(const String &macStr, uint8_t* macAddr) {
-  sscanf(macStr.c_str(), "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx", 
+void parseMacAddress(const char* macStr, uint8_t* macAddr) {
+  sscanf(macStr, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx", 
          &macAddr[0], &macAddr[1], &macAddr[2], 
          &macAddr[3], &macAddr[4], &macAddr[5]);
 }
@@ -2,11 +2,16 @@
 #define PACKET_ANALYZER_H
 
 #include "../core/globals.h"
+#include "../core/frame_decoder.h"
 
-void analyzePacket(const wifi_promiscuous_pkt_t* pkt);
-String getProtocolName(uint8_t type);
-String macToString(const uint8_t* mac);
+void analyzePacket(const wifi_promiscuous_pkt_t* pkt, const FrameInfo& info);
+const char* getProtocolName(uint8_t type);
+FixedString<18> macToString(const uint8_t* mac);
 void promisc_cb(void* buf, wifi_promiscuous_pkt_type_t type);
-void parseMacAddress(const String &macStr, uint8_t* macAddr);
+void resetCaptureStats();
+CaptureStats readCaptureStats();
+void readPacketLogs(LogList<LOG_ENTRY_LEN>& out);
+void printCaptureStats(Print& out);
+void parseMacAddress(const char* macStr, uint8_t* macAddr);
 
 #endif
@@ -0,0 +1,108 @@
+#include "settings.h"
+#include <Preferences.h>
+#include "attack_modes.h"
+#include "../output/lcd_handler.h"
+#include "../input/input_trace.h"
+
+// Settings and the last target live in NVS so a sensor that reboots in
+// the field goes straight back to monitoring. NVS skips writes of
+// unchanged values, so saving everything on each change is cheap.
+
+#define SETTINGS_NAMESPACE "striker"
+
+static Preferences prefs;
+static bool prefsOpen = false;
+
+void settingsBegin() {
+  prefsOpen = prefs.begin(SETTINGS_NAMESPACE, false);
+  if (!prefsOpen) return;
+  statusServerEnabled = prefs.getBool("dashboard", statusServerEnabled);
+
+  char pw[DASHBOARD_PASSWORD_MAX + 1];
+  if (prefs.isKey("dashpass") && prefs.getString("dashpass", pw, sizeof(pw)) > 0) {
+    dashboardPassword = pw;
+  }
+}
+
+// Dashboard flag and the selected target network
+void saveSettings() {
+  if (!prefsOpen || replayActive()) return;
+  prefs.putBool("dashboard", statusServerEnabled);
+  if (selectedNetwork < 0) return;
+
+  const WiFiNetwork& net = networks[selectedNetwork];
+  prefs.putString("ssid", net.ssid.c_str());
+  prefs.putString("bssid", net.bssid.c_str());
+  prefs.putString("enc", net.encryption);
+  prefs.putUChar("channel", net.channel);
+  prefs.putInt("rssi", net.rssi);
+}
+
+// Stored on its own so the password is only written when it changes
+void saveDashboardPassword() {
+  if (!prefsOpen || replayActive()) return;
+  prefs.putString("dashpass", dashboardPassword.c_str());
+}
+
+// Mode to come back to after a reboot; only sniffing resumes on its own.
+// A replay never enters PS mode, but its H can stop a real session, and
+// that must still clear the flag.
+void saveResumeMode(AppState mode) {
+  if (!prefsOpen || (replayActive() && mode == PS_MODE)) return;
+  prefs.putUChar("mode", mode == PS_MODE ? PS_MODE : MAIN_MENU);
+}
+
+static const char* encryptionLabel(const char* saved) {
+  for (int m = WIFI_AUTH_OPEN; m <= WIFI_AUTH_WPA2_ENTERPRISE; m++) {
+    const char* label = getEncryptionType((wifi_auth_mode_t)m);
+    if (strcmp(label, saved) == 0) return label;
+  }
+  return getEncryptionType((wifi_auth_mode_t)-1);
+}
+
+// Puts the saved target back as the only known network and resumes
+// sniffing if that was the last mode. Returns true if a screen was drawn.
+bool restoreLastMode() {
+  if (!prefsOpen || !prefs.isKey("bssid")) return false;
+
+  char buf[33];
+  WiFiNetwork& net = networks[0];
+  prefs.getString("ssid", buf, sizeof(buf));
+  net.ssid = buf;
+  prefs.getString("bssid", buf, sizeof(buf));
+  net.bssid = buf;
+  prefs.getString("enc", buf, sizeof(buf));
+  net.encryption = encryptionLabel(buf);
+  net.channel = prefs.getUChar("channel", 1);
+  net.rssi = prefs.getInt("rssi", 0);
+  networkCount = 1;
+  selectedNetwork = 0;
+
+  if (prefs.getUChar("mode", MAIN_MENU) != PS_MODE) return false;
+  bootTiming.resumed = true;
+  enterPSMode();
+  return true;
+}
+
+static void printMillis(Print& out, const char* label, uint32_t ms) {
+  if (ms) {
+    out.printf("%s: %lu ms\n", label, (unsigned long)ms);
+  } else {
+    out.printf("%s: -\n", label);
+  }
+}
+
+// Reports boot timing once, when the first target frame comes in
+void updateBootTiming() {
+  static bool reported = false;
+  if (reported || !bootTiming.firstCapture) return;
+  reported = true;
+  printBootReport(Serial);
+}
+
+void printBootReport(Print& out) {
+  out.printf("Boot: %s\n", bootTiming.resumed ? "resumed sniffing" : "main menu");
+  printMillis(out, "First screen", bootTiming.firstScreen);
+  printMillis(out, "First frame", bootTiming.firstFrame);
+  printMillis(out, "First capture", bootTiming.firstCapture);
+}
@@ -0,0 +1,14 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include "../core/globals.h"
+
+void settingsBegin();
+void saveSettings();
+void saveDashboardPassword();
+void saveResumeMode(AppState mode);
+bool restoreLastMode();
+void updateBootTiming();
+void printBootReport(Print& out);
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef STATUS_ASSETS_H
+#define STATUS_ASSETS_H
+
+#include <Arduino.h>
+
+// Generated from extras/dashboard/ - do not edit by hand.
+// Regenerate each array with: gzip -9 -n -c extras/dashboard/<file> | xxd -i
+
+// index.html: 932 bytes, 512 gzipped
+static const uint8_t STATUS_INDEX_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x53,
+  0xc1, 0x8e, 0xd3, 0x30, 0x10, 0xbd, 0xf7, 0x2b, 0x86, 0x54, 0xdc, 0x48,
+  0xd2, 0x50, 0xb1, 0x82, 0x26, 0xad, 0x04, 0x5b, 0x56, 0x82, 0x03, 0x20,
+  0x8a, 0x84, 0x38, 0x3a, 0xb1, 0xd3, 0x0c, 0x75, 0x9c, 0xc8, 0x9e, 0xb6,
+  0xbb, 0x8b, 0xf6, 0xdf, 0x19, 0x3b, 0x49, 0x57, 0x2b, 0xad, 0xf6, 0x52,
+  0x7b, 0x66, 0x3c, 0xef, 0xbd, 0x99, 0xd7, 0x14, 0xaf, 0xb6, 0xdf, 0xaf,
+  0x7f, 0xfd, 0xf9, 0xf1, 0x19, 0x1a, 0x6a, 0xf5, 0x66, 0x56, 0x4c, 0x87,
+  0x12, 0x92, 0x8f, 0x56, 0x91, 0x80, 0xaa, 0x11, 0xd6, 0x29, 0x5a, 0x47,
+  0x47, 0xaa, 0xe3, 0xf7, 0xd1, 0x94, 0x36, 0xa2, 0x55, 0xeb, 0xe8, 0x84,
+  0xea, 0xdc, 0x77, 0x96, 0x22, 0xa8, 0x3a, 0x43, 0xca, 0xf0, 0xb3, 0x33,
+  0x4a, 0x6a, 0xd6, 0x52, 0x9d, 0xb0, 0x52, 0x71, 0x08, 0xde, 0x00, 0x1a,
+  0x24, 0x14, 0x3a, 0x76, 0x95, 0xd0, 0x6a, 0x9d, 0x79, 0x10, 0x42, 0xd2,
+  0x6a, 0xf3, 0x1b, 0x6f, 0x10, 0x76, 0x64, 0xf1, 0xa0, 0x2c, 0x38, 0x12,
+  0x74, 0x74, 0x45, 0x3a, 0x94, 0x66, 0x85, 0xa3, 0x3b, 0x7f, 0x96, 0x9d,
+  0xbc, 0x83, 0x7f, 0x50, 0x33, 0x41, 0x5c, 0x8b, 0x16, 0xf5, 0xdd, 0x0a,
+  0x9c, 0x30, 0x2e, 0x76, 0xca, 0x62, 0x9d, 0x43, 0x2b, 0xec, 0x1e, 0xcd,
+  0x0a, 0x32, 0xd5, 0xe6, 0x50, 0x8a, 0xea, 0xb0, 0xb7, 0xdd, 0xd1, 0xc8,
+  0x15, 0xcc, 0xb3, 0x2c, 0xcb, 0x59, 0x98, 0xee, 0x2c, 0x07, 0x52, 0xca,
+  0x1c, 0x1e, 0x66, 0x4d, 0x36, 0x61, 0x39, 0xbc, 0x57, 0xdc, 0x95, 0xbc,
+  0xf5, 0x7d, 0x0f, 0x33, 0x12, 0xa5, 0x56, 0x5c, 0x2b, 0x3b, 0x2b, 0x95,
+  0x8d, 0xb9, 0x4d, 0x8b, 0xde, 0xf1, 0x8b, 0xe9, 0x96, 0x43, 0x98, 0x86,
+  0x5b, 0x16, 0x8b, 0xd7, 0x13, 0x6d, 0x5c, 0x76, 0x44, 0x5d, 0x3b, 0xb2,
+  0x33, 0x0a, 0x4f, 0x4b, 0xf2, 0x11, 0xe6, 0x52, 0xee, 0x6f, 0xc1, 0x75,
+  0x1a, 0x25, 0xcc, 0x97, 0xcb, 0x65, 0x0e, 0xbd, 0x90, 0x12, 0xcd, 0x7e,
+  0x05, 0x0b, 0xcf, 0xcf, 0xbf, 0xef, 0x7c, 0x3f, 0xa9, 0x5b, 0x8a, 0x85,
+  0xc6, 0x3d, 0x8f, 0xa3, 0x55, 0x4d, 0x1e, 0x71, 0xee, 0xd7, 0xe2, 0xc0,
+  0xf5, 0xc2, 0x30, 0xac, 0x44, 0xd7, 0x6b, 0xc1, 0x1b, 0x40, 0xa3, 0xd1,
+  0xa8, 0xb8, 0xd4, 0x5d, 0x75, 0x60, 0x31, 0xac, 0x64, 0x54, 0xf7, 0x61,
+  0x10, 0x92, 0xf0, 0xa6, 0x2d, 0x71, 0xc7, 0x34, 0x7f, 0x7d, 0x75, 0xe5,
+  0xf3, 0x45, 0x3a, 0xae, 0xb5, 0x48, 0x47, 0x97, 0xfd, 0x7e, 0xbd, 0xe7,
+  0xd9, 0xf3, 0x6e, 0x70, 0x7e, 0x56, 0x48, 0x3c, 0x01, 0xca, 0x75, 0x14,
+  0xb4, 0x44, 0x1b, 0x36, 0xdb, 0xa8, 0x8a, 0x78, 0x80, 0x24, 0x49, 0x8a,
+  0x94, 0xab, 0x03, 0xc0, 0x47, 0xcf, 0x39, 0xf5, 0x84, 0x85, 0x6e, 0x0a,
+  0x0a, 0x34, 0x05, 0x59, 0x7f, 0xdd, 0x7c, 0xda, 0xed, 0xbe, 0x6c, 0xd9,
+  0xe2, 0x26, 0x44, 0x37, 0x5a, 0xec, 0xdd, 0x25, 0xfa, 0x8a, 0x44, 0x4c,
+  0x7c, 0x7c, 0xcc, 0x6c, 0xd9, 0x60, 0x82, 0xbe, 0x6f, 0x87, 0x4c, 0xea,
+  0x41, 0xd2, 0x09, 0x30, 0xfc, 0x2f, 0xbc, 0xa8, 0x30, 0x29, 0xab, 0xe2,
+  0x52, 0x98, 0x85, 0xcf, 0x40, 0x1d, 0x24, 0x7d, 0x53, 0x74, 0xee, 0xec,
+  0xe1, 0x45, 0x51, 0x4f, 0x34, 0x3d, 0x55, 0x78, 0xdd, 0x5c, 0xae, 0x3f,
+  0xb9, 0x70, 0x09, 0x76, 0xaa, 0x7a, 0x51, 0x93, 0x19, 0x69, 0x9f, 0x53,
+  0xe5, 0x2a, 0x8b, 0x3d, 0x81, 0xb3, 0x15, 0x6b, 0xef, 0xfb, 0xe4, 0x6f,
+  0x78, 0x35, 0x64, 0xbd, 0x2f, 0xa3, 0x21, 0xe9, 0xf0, 0x31, 0xfe, 0x07,
+  0xcf, 0xad, 0x02, 0x25, 0xa4, 0x03, 0x00, 0x00,
+};
+
+// app.js: 1138 bytes, 510 gzipped
+static const uint8_t STATUS_APP_JS_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x53,
+  0x4d, 0x8f, 0xda, 0x30, 0x10, 0xbd, 0xe7, 0x57, 0xcc, 0xcd, 0x46, 0x8d,
+  0x4c, 0x7b, 0x2d, 0xea, 0xa5, 0x88, 0xc3, 0x56, 0xd5, 0xae, 0xd4, 0xed,
+  0xad, 0xea, 0xc1, 0xd8, 0x93, 0xc5, 0x10, 0x6c, 0x64, 0x4f, 0xa0, 0xa8,
+  0xda, 0xff, 0xde, 0xb1, 0xc3, 0x47, 0xc8, 0xb2, 0x8d, 0x44, 0xb0, 0xe7,
+  0xbd, 0x99, 0x79, 0xf3, 0x91, 0xa6, 0xf3, 0x86, 0x5c, 0xf0, 0x60, 0xb0,
+  0x6d, 0x65, 0x0c, 0x87, 0x1a, 0x08, 0xff, 0x50, 0x0d, 0xa6, 0x4d, 0x13,
+  0xf8, 0x5b, 0x01, 0xec, 0x75, 0x04, 0xb2, 0xf0, 0x05, 0x18, 0x54, 0xce,
+  0x27, 0x8c, 0x34, 0xcf, 0xdc, 0xc9, 0x8c, 0x41, 0xb2, 0x2a, 0xd3, 0xe7,
+  0xc1, 0x13, 0x7a, 0x62, 0x52, 0xbe, 0x65, 0xc0, 0x35, 0x20, 0x4b, 0x08,
+  0x66, 0x98, 0x56, 0xa7, 0xf4, 0xa8, 0xb7, 0xc8, 0x38, 0xdb, 0x66, 0xd5,
+  0x6b, 0x55, 0x35, 0xe7, 0xbc, 0x8d, 0xe3, 0x58, 0xce, 0xd6, 0xd0, 0xc5,
+  0xb6, 0x86, 0x88, 0xde, 0x62, 0xec, 0x13, 0x37, 0x48, 0x66, 0x25, 0xd9,
+  0x3c, 0x51, 0xb4, 0x42, 0x2f, 0x2f, 0x2e, 0x32, 0x13, 0x98, 0x4a, 0x5d,
+  0xf4, 0x10, 0xd5, 0x3a, 0x05, 0xcf, 0x6a, 0xe0, 0xf5, 0x0d, 0xcf, 0x11,
+  0x6e, 0x4f, 0x55, 0xf4, 0x75, 0x2c, 0x83, 0x3d, 0xb2, 0x08, 0x1b, 0x4c,
+  0xb7, 0x65, 0xbd, 0xea, 0x05, 0x69, 0xd1, 0x62, 0x3e, 0x7e, 0x3d, 0x3e,
+  0x58, 0x96, 0x51, 0x8a, 0x82, 0xc2, 0x1b, 0x15, 0x26, 0x44, 0x0f, 0x95,
+  0x98, 0xaa, 0x09, 0x71, 0xa1, 0x59, 0xdd, 0x6d, 0xae, 0x5e, 0x56, 0xae,
+  0x40, 0x96, 0x08, 0x7d, 0xb7, 0x7e, 0x84, 0x83, 0x9c, 0xd4, 0xc5, 0xb1,
+  0xa8, 0xcc, 0x71, 0xf2, 0x7b, 0xd8, 0x85, 0x88, 0x4d, 0xc4, 0xb4, 0xfa,
+  0xa9, 0x97, 0x2d, 0x26, 0x79, 0xaa, 0x3f, 0x77, 0x46, 0x78, 0xa4, 0x43,
+  0x88, 0x9b, 0x24, 0x6a, 0x10, 0x53, 0xbd, 0x73, 0xd3, 0x81, 0x61, 0xd0,
+  0x91, 0x3c, 0x38, 0x7f, 0x2e, 0xf5, 0x3a, 0x4b, 0xaf, 0x52, 0xca, 0x55,
+  0xdd, 0x98, 0x96, 0x77, 0x6c, 0x66, 0x35, 0x32, 0x44, 0x26, 0x8d, 0x4c,
+  0x09, 0xcd, 0x45, 0xfc, 0x59, 0x9e, 0x6e, 0xb9, 0xc2, 0xab, 0xb8, 0xcb,
+  0x75, 0x24, 0x4d, 0xbf, 0x95, 0xa6, 0x7b, 0x1d, 0xec, 0x59, 0x9c, 0xc4,
+  0x4d, 0x32, 0xad, 0x9a, 0x56, 0xbf, 0xa4, 0xf7, 0xc0, 0xb5, 0x23, 0xe2,
+  0x35, 0xb9, 0x35, 0xda, 0xe8, 0x1a, 0x1a, 0x76, 0x37, 0x4f, 0x1c, 0xf7,
+  0x3c, 0xbe, 0xc4, 0xf3, 0xf3, 0x78, 0x80, 0x45, 0xbe, 0x3c, 0x87, 0x2e,
+  0x1a, 0x94, 0x62, 0xda, 0x43, 0x1c, 0xba, 0xea, 0x4f, 0x4a, 0x5b, 0x5b,
+  0x18, 0xdf, 0x5d, 0xe2, 0xa1, 0xf3, 0x10, 0x45, 0x22, 0x3d, 0xaa, 0x06,
+  0xaf, 0x1f, 0x45, 0x8e, 0xfa, 0xed, 0xf9, 0xe9, 0x51, 0xed, 0x74, 0x4c,
+  0x28, 0x51, 0x59, 0x4d, 0xba, 0xe4, 0xcf, 0x68, 0xe8, 0xe8, 0x3f, 0x9b,
+  0x76, 0x8a, 0x5c, 0xd8, 0xcc, 0xbc, 0xbb, 0x6b, 0x4f, 0xcb, 0x35, 0x1a,
+  0x52, 0x1b, 0x3c, 0x26, 0x99, 0x26, 0x77, 0x56, 0x6e, 0x33, 0x5c, 0xed,
+  0xb4, 0xd3, 0x7e, 0x98, 0xd0, 0x44, 0xd4, 0x84, 0xa7, 0x9c, 0x9c, 0x8f,
+  0x61, 0x71, 0xda, 0xee, 0x7c, 0x1e, 0x65, 0xdc, 0xc0, 0x07, 0x10, 0x9f,
+  0x41, 0xf0, 0x5f, 0xfa, 0xb5, 0xf9, 0xdd, 0xf3, 0xb2, 0x30, 0xbd, 0xdb,
+  0xf1, 0x42, 0xcf, 0x57, 0xae, 0xb5, 0x32, 0xfb, 0x5d, 0xfb, 0xcb, 0xbf,
+  0x6a, 0xb4, 0xb6, 0xb3, 0x2a, 0x21, 0x3d, 0x70, 0xcc, 0xb8, 0xd7, 0x3c,
+  0x96, 0x21, 0x58, 0xc3, 0xa7, 0x8f, 0xfc, 0x30, 0xe5, 0x1f, 0xf1, 0x7f,
+  0x00, 0xa3, 0x72, 0x04, 0x00, 0x00,
+};
+
+#endif
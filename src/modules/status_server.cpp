@@ -0,0 +1,312 @@
+#include "status_server.h"
+#include "status_assets.h"
+#include "beacon_analyzer.h"
+#include "packet_analyzer.h"
+#include "heap_monitor.h"
+#include "survey_history.h"
+#include <lwip/sockets.h>
+#include "../input/input_trace.h"
+
+// Read-only dashboard for our own deployments. It runs on a WPA2
+// management AP behind HTTP basic auth. Static files are pre-gzipped in
+// flash and sent as-is; dynamic data is written out in small chunks or
+// as Server-Sent Events, so no response is ever built whole in RAM.
+
+struct StaticAsset {
+  const char* path;
+  const char* type;
+  const uint8_t* data;
+  size_t len;
+};
+
+static const StaticAsset ASSETS[] = {
+  { "/", "text/html", STATUS_INDEX_HTML_GZ, sizeof(STATUS_INDEX_HTML_GZ) },
+  { "/app.js", "application/javascript", STATUS_APP_JS_GZ, sizeof(STATUS_APP_JS_GZ) },
+};
+
+static WiFiClient sseClients[MAX_SSE_CLIENTS];
+static bool running = false;
+static bool routesAdded = false;
+static unsigned long lastPush = 0;
+static unsigned long rateWindowStart = 0;
+static uint32_t windowRequests = 0;
+static uint32_t idleFreeHeap = 0;
+
+template <size_t N>
+static void appendJsonString(FixedString<N>& out, const char* s) {
+  out += '"';
+  for (; *s; s++) {
+    if (*s == '"' || *s == '\\') {
+      out += '\\';
+      out += *s;
+    } else if ((uint8_t)*s < 0x20) {
+      out.appendf("\\u%04x", (uint8_t)*s);
+    } else {
+      out += *s;
+    }
+  }
+  out += '"';
+}
+
+static int activeStreams() {
+  int count = 0;
+  for (int i = 0; i < MAX_SSE_CLIENTS; i++) {
+    if (sseClients[i].connected()) count++;
+  }
+  return count;
+}
+
+// Heap held by the request being served, relative to the idle baseline
+static void noteRequestHeap() {
+  uint32_t freeNow = ESP.getFreeHeap();
+  uint32_t streamCost = statusStats.heapPerStream * activeStreams();
+  if (idleFreeHeap > freeNow + streamCost) {
+    uint32_t cost = idleFreeHeap - freeNow - streamCost;
+    if (cost > statusStats.heapPerRequest) statusStats.heapPerRequest = cost;
+  }
+}
+
+static bool beginRequest() {
+  if (!statusServer.authenticate(STATUS_USER, dashboardPassword.c_str())) {
+    statusServer.requestAuthentication();
+    return false;
+  }
+  statusStats.requests++;
+  windowRequests++;
+  noteRequestHeap();
+  return true;
+}
+
+static void serveAsset(const StaticAsset& asset) {
+  if (!beginRequest()) return;
+  statusServer.sendHeader("Content-Encoding", "gzip");
+  statusServer.sendHeader("Cache-Control", "max-age=86400");
+  statusServer.send_P(200, asset.type, (const char*)asset.data, asset.len);
+  noteRequestHeap();
+}
+
+static void buildStatsJson(FixedString<STATUS_JSON_LEN>& json) {
+  CaptureStats stats = readCaptureStats();
+  json.appendf("{\"uptime\":%lu,\"state\":\"%s\",\"packets\":%lu,\"http\":%d,\"dns\":%d,"
+               "\"tcp\":%d,\"udp\":%d,\"arp\":%d,\"networks\":%d,\"suspects\":%d,",
+               millis() / 1000, stateName(currentState), (unsigned long)stats.framesPerWindow,
+               stats.http, stats.dns, stats.tcp, stats.udp, stats.arp, networkCount,
+               stats.suspectAps);
+  json.appendf("\"heap\":%lu,\"maxBlock\":%lu,\"frag\":%u,\"rps\":%lu,\"streams\":%d,"
+               "\"heapPerReq\":%lu,\"heapPerStream\":%lu}",
+               (unsigned long)heapStats.freeBytes, (unsigned long)heapStats.largestBlock,
+               heapStats.fragmentation, (unsigned long)statusStats.requestsPerSec,
+               activeStreams(), (unsigned long)statusStats.heapPerRequest,
+               (unsigned long)statusStats.heapPerStream);
+}
+
+static void handleStats() {
+  if (!beginRequest()) return;
+  FixedString<STATUS_JSON_LEN> json;
+  buildStatsJson(json);
+  statusServer.send(200, "application/json", json.c_str());
+}
+
+static void beginChunkedJson() {
+  statusServer.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  statusServer.send(200, "application/json", "");
+  statusServer.sendContent("[", 1);
+}
+
+static void endChunkedJson() {
+  statusServer.sendContent("]", 1);
+  noteRequestHeap();
+  statusServer.sendContent("", 0);
+}
+
+static void handleNetworks() {
+  if (!beginRequest()) return;
+  beginChunkedJson();
+  for (int i = 0; i < networkCount; i++) {
+    FixedString<STATUS_JSON_LEN> row;
+    if (i > 0) row += ',';
+    row += "{\"ssid\":";
+    appendJsonString(row, networks[i].ssid.c_str());
+    row.appendf(",\"bssid\":\"%s\",\"ch\":%u,\"rssi\":%ld,\"sec\":\"%s\"}",
+                networks[i].bssid.c_str(), networks[i].channel,
+                (long)networks[i].rssi, networks[i].encryption);
+    statusServer.sendContent(row.c_str(), row.length());
+  }
+  endChunkedJson();
+}
+
+// Served from the published summary; the callback owns the live tracks
+static void handleAlerts() {
+  if (!beginRequest()) return;
+  TableSummary summary = tableSnapshot.read();
+  beginChunkedJson();
+  for (int i = 0; i < summary.alertCount; i++) {
+    const AlertRow& a = summary.alerts[i];
+    FixedString<STATUS_JSON_LEN> row;
+    if (i > 0) row += ',';
+    row.appendf("{\"bssid\":\"%s\",\"flags\":\"%s\",\"jitter\":%ld,\"drift\":%ld}",
+                macToString(a.bssid).c_str(), beaconAnomalyString(a.flags).c_str(),
+                (long)a.jitterUs, (long)a.driftPpm);
+    statusServer.sendContent(row.c_str(), row.length());
+  }
+  endChunkedJson();
+}
+
+// WiFiClient::write waits until the socket takes every byte, so one
+// stalled browser would freeze the LCD and joystick. Send without
+// waiting instead; a short or refused send means the slot gets dropped.
+static bool pushStats(WiFiClient& client) {
+  FixedString<STATUS_JSON_LEN + 24> event;
+  FixedString<STATUS_JSON_LEN> json;
+  buildStatsJson(json);
+  event.appendf("event: stats\ndata: %s\n\n", json.c_str());
+  int sent = send(client.fd(), event.c_str(), event.length(), MSG_DONTWAIT);
+  return sent == (int)event.length();
+}
+
+// Keeps the socket open past the handler: WebServer drops its own
+// reference when the handler returns, ours keeps the stream alive
+static void handleEvents() {
+  if (!beginRequest()) return;
+
+  int slot = -1;
+  for (int i = 0; i < MAX_SSE_CLIENTS; i++) {
+    if (!sseClients[i].connected()) slot = i;
+  }
+  if (slot < 0) {
+    statusServer.send(503, "text/plain", "Too many streams");
+    return;
+  }
+
+  WiFiClient client = statusServer.client();
+  client.print("HTTP/1.1 200 OK\r\n"
+               "Content-Type: text/event-stream\r\n"
+               "Cache-Control: no-cache\r\n"
+               "Connection: keep-alive\r\n\r\n");
+  sseClients[slot] = client;
+  pushStats(sseClients[slot]);
+}
+
+static void handleNotFound() {
+  if (!beginRequest()) return;
+  statusServer.send(404, "text/plain", "Not found");
+}
+
+// The AP and the sniffer share one radio channel; in PS mode it belongs
+// to the target network
+static uint8_t mgmtChannel() {
+  if (currentState == PS_MODE && selectedNetwork >= 0) return networks[selectedNetwork].channel;
+  return 1;
+}
+
+// Mode switches can retune the radio, so put it back on the target
+static void restoreSniffChannel() {
+  if (currentState != PS_MODE) return;
+  esp_wifi_set_channel(mgmtChannel(), WIFI_SECOND_CHAN_NONE);
+}
+
+void statusServerStart() {
+  if (running || dashboardPassword.empty()) return;
+  surveyCancelScan();
+
+  WiFi.mode(WIFI_AP_STA);
+  WiFi.softAPConfig(mgmtIP, mgmtIP, IPAddress(255, 255, 255, 0));
+  bool started = WiFi.softAP(MGMT_SSID, dashboardPassword.c_str(), mgmtChannel());
+  restoreSniffChannel();
+  if (!started) return;
+
+  if (!routesAdded) {
+    for (size_t i = 0; i < sizeof(ASSETS) / sizeof(ASSETS[0]); i++) {
+      const StaticAsset* asset = &ASSETS[i];
+      statusServer.on(asset->path, HTTP_GET, [asset]() { serveAsset(*asset); });
+    }
+    statusServer.on("/api/stats", HTTP_GET, handleStats);
+    statusServer.on("/api/networks", HTTP_GET, handleNetworks);
+    statusServer.on("/api/alerts", HTTP_GET, handleAlerts);
+    statusServer.on("/events", HTTP_GET, handleEvents);
+    statusServer.onNotFound(handleNotFound);
+    routesAdded = true;
+  }
+
+  statusServer.begin();
+  idleFreeHeap = ESP.getFreeHeap();
+  rateWindowStart = millis();
+  windowRequests = 0;
+  running = true;
+}
+
+void statusServerStop() {
+  if (!running) return;
+  for (int i = 0; i < MAX_SSE_CLIENTS; i++) {
+    sseClients[i].stop();
+  }
+  statusServer.stop();
+  WiFi.softAPdisconnect(true);
+  WiFi.mode(WIFI_STA);
+  restoreSniffChannel();
+  running = false;
+}
+
+bool statusServerRunning() {
+  return running;
+}
+
+void updateStatusServer() {
+  // The management AP shares the radio with the MITM and AP modes, and
+  // starting it would cut short a scan the user asked for
+  bool apBusy = currentState == MITM_MODE || currentState == AP_MODE ||
+                currentState == SCAN_MODE;
+  static unsigned long lastStartAttempt = 0;
+  static bool warned = false;
+  if (statusServerEnabled && dashboardPassword.empty()) {
+    if (!warned) Serial.println("Dashboard: no password set, use 'dashboard password <pw>'");
+    warned = true;
+  } else if (statusServerEnabled && !running && !apBusy && millis() - lastStartAttempt > 5000) {
+    lastStartAttempt = millis();
+    statusServerStart();
+  } else if (running && !statusServerEnabled) {
+    statusServerStop();
+  }
+  if (!running) return;
+
+  statusServer.handleClient();
+
+  int streams = activeStreams();
+  uint32_t freeNow = ESP.getFreeHeap();
+  if (streams == 0) {
+    idleFreeHeap = freeNow;
+  } else if (idleFreeHeap > freeNow) {
+    statusStats.heapPerStream = (idleFreeHeap - freeNow) / streams;
+  }
+
+  if (millis() - rateWindowStart >= 1000) {
+    unsigned long elapsed = millis() - rateWindowStart;
+    statusStats.requestsPerSec = windowRequests * 1000 / elapsed;
+    if (statusStats.requestsPerSec > statusStats.peakRequestsPerSec) {
+      statusStats.peakRequestsPerSec = statusStats.requestsPerSec;
+    }
+    windowRequests = 0;
+    rateWindowStart = millis();
+  }
+
+  if (streams > 0 && millis() - lastPush >= STATUS_PUSH_INTERVAL) {
+    lastPush = millis();
+    for (int i = 0; i < MAX_SSE_CLIENTS; i++) {
+      if (sseClients[i].connected() && !pushStats(sseClients[i])) {
+        sseClients[i].stop();
+      }
+    }
+  }
+}
+
+void printStatusReport(Print& out) {
+  out.printf("Dashboard: %s, %s, %s\n", statusServerEnabled ? "enabled" : "disabled",
+             running ? "running" : "stopped",
+             dashboardPassword.empty() ? "no password set" : "password set");
+  out.printf("Requests: %lu total, %lu/s (peak %lu/s)\n",
+             (unsigned long)statusStats.requests, (unsigned long)statusStats.requestsPerSec,
+             (unsigned long)statusStats.peakRequestsPerSec);
+  out.printf("Streams: %d, heap %lu per stream, %lu peak per request\n",
+             activeStreams(), (unsigned long)statusStats.heapPerStream,
+             (unsigned long)statusStats.heapPerRequest);
+}
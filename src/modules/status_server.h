@@ -0,0 +1,16 @@
+#ifndef STATUS_SERVER_H
+#define STATUS_SERVER_H
+
+#include "../core/globals.h"
+
+#define MAX_SSE_CLIENTS 2
+#define STATUS_PUSH_INTERVAL 1000
+#define STATUS_JSON_LEN 320
+
+void statusServerStart();
+void statusServerStop();
+bool statusServerRunning();
+void updateStatusServer();
+void printStatusReport(Print& out);
+
+#endif
@@ -0,0 +1,482 @@
+#include "survey_history.h"
+#include <esp_partition.h>
+#include "wifi_scanner.h"
+
+// Flash layout: the partition is a ring of 4 KB sectors used as an
+// append-only log. Each sector starts with a header and is followed by
+// records until the first erased (0xFF) byte. When the head sector is full
+// the next one in the ring is erased, so every sector wears evenly.
+#define SURVEY_MAGIC 0x31565253  // "SRV1"
+#define TAG_DEFINE 0x01  // bssid[6] channel: assigns the next sector-local id
+#define TAG_SCAN 0x02    // varint dt, varint n, n x (varint id, zigzag rssi delta)
+#define TAG_BOOT 0x03    // varint dt: device rebooted
+#define TAG_ERASED 0xFF
+
+struct SurveySectorHeader {
+  uint32_t magic;
+  uint32_t sequence;
+  uint32_t baseTime;
+  // Bloom filter of the BSSIDs in this sector. Bits start erased (1) and
+  // are cleared in place, which flash allows without another erase.
+  uint8_t bloom[SURVEY_BLOOM_BYTES];
+};
+
+// BSSIDs defined so far in one sector, with the running RSSI per id
+struct SurveyDict {
+  uint8_t count;
+  uint8_t bssid[SURVEY_MAX_IDS][6];
+  uint8_t channel[SURVEY_MAX_IDS];
+  int8_t lastRssi[SURVEY_MAX_IDS];
+};
+
+struct SurveyFilter {
+  const uint8_t* bssid;
+  uint32_t from;
+  uint32_t to;
+  SurveyVisitor visit;
+  void* ctx;
+};
+
+struct SectorReader {
+  int sector;
+  uint32_t pos;
+  uint32_t bufStart;
+  uint32_t bufLen;
+  uint8_t buf[128];
+};
+
+static const esp_partition_t* surveyPartition = nullptr;
+static int sectorCount = 0;
+static uint32_t sectorSeq[SURVEY_MAX_SECTORS];  // 0 = never written
+static uint32_t sectorTime[SURVEY_MAX_SECTORS];
+static int headSector = -1;
+static uint32_t writeOffset = 0;
+static uint32_t lastRecordTime = 0;
+static uint32_t bootBaseTime = 0;
+static SurveyDict headDict;
+static uint8_t headBloom[SURVEY_BLOOM_BYTES];
+static SurveyDict queryDict;
+
+static int putVarint(uint8_t* buf, uint32_t v) {
+  int n = 0;
+  while (v >= 0x80) {
+    buf[n++] = (v & 0x7F) | 0x80;
+    v >>= 7;
+  }
+  buf[n++] = v;
+  return n;
+}
+
+static uint32_t zigzag(int32_t v) {
+  return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static void bloomBits(const uint8_t* mac, int& a, int& b) {
+  uint32_t h = 2166136261u;
+  for (int i = 0; i < 6; i++) {
+    h = (h ^ mac[i]) * 16777619u;
+  }
+  a = h % (SURVEY_BLOOM_BYTES * 8);
+  b = (h >> 16) % (SURVEY_BLOOM_BYTES * 8);
+}
+
+static bool bloomContains(const uint8_t* bloom, const uint8_t* mac) {
+  int a, b;
+  bloomBits(mac, a, b);
+  return !(bloom[a / 8] & (1 << (a % 8))) && !(bloom[b / 8] & (1 << (b % 8)));
+}
+
+static size_t sectorAddress(int sector) {
+  return (size_t)sector * SURVEY_SECTOR_SIZE;
+}
+
+static bool readByte(SectorReader& r, uint8_t& b) {
+  if (r.pos >= SURVEY_SECTOR_SIZE) return false;
+  if (r.pos < r.bufStart || r.pos >= r.bufStart + r.bufLen) {
+    r.bufStart = r.pos;
+    r.bufLen = min((uint32_t)sizeof(r.buf), (uint32_t)SURVEY_SECTOR_SIZE - r.pos);
+    if (esp_partition_read(surveyPartition, sectorAddress(r.sector) + r.bufStart, r.buf, r.bufLen) != ESP_OK) {
+      r.bufLen = 0;
+      return false;
+    }
+  }
+  b = r.buf[r.pos - r.bufStart];
+  r.pos++;
+  return true;
+}
+
+static bool readVarint(SectorReader& r, uint32_t& v) {
+  v = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    uint8_t b;
+    if (!readByte(r, b)) return false;
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+// Walks the records of one sector. Returns false on a truncated or corrupt
+// record; end is left at the start of the first record not decoded.
+static bool decodeSector(int sector, SurveyDict& dict, uint32_t& time, uint32_t& end, const SurveyFilter* filter) {
+  SectorReader r = {};
+  r.sector = sector;
+  r.pos = sizeof(SurveySectorHeader);
+  dict.count = 0;
+  time = sectorTime[sector];
+
+  while (true) {
+    end = r.pos;
+    uint8_t tag;
+    if (!readByte(r, tag) || tag == TAG_ERASED) return true;
+
+    if (tag == TAG_DEFINE) {
+      if (dict.count >= SURVEY_MAX_IDS) return false;
+      for (int i = 0; i < 6; i++) {
+        if (!readByte(r, dict.bssid[dict.count][i])) return false;
+      }
+      if (!readByte(r, dict.channel[dict.count])) return false;
+      dict.lastRssi[dict.count] = 0;
+      dict.count++;
+    } else if (tag == TAG_SCAN || tag == TAG_BOOT) {
+      uint32_t dt;
+      if (!readVarint(r, dt)) return false;
+      time += dt;
+      if (tag == TAG_BOOT) continue;
+
+      uint32_t n;
+      if (!readVarint(r, n) || n > SURVEY_MAX_PER_SCAN) return false;
+      for (uint32_t k = 0; k < n; k++) {
+        uint32_t id, delta;
+        if (!readVarint(r, id) || !readVarint(r, delta) || id >= dict.count) return false;
+        dict.lastRssi[id] += unzigzag(delta);
+
+        if (filter && time >= filter->from && time <= filter->to &&
+            (!filter->bssid || memcmp(filter->bssid, dict.bssid[id], 6) == 0)) {
+          SurveyPoint point;
+          point.time = time;
+          memcpy(point.bssid, dict.bssid[id], 6);
+          point.channel = dict.channel[id];
+          point.rssi = dict.lastRssi[id];
+          filter->visit(point, filter->ctx);
+        }
+      }
+    } else {
+      return false;
+    }
+  }
+}
+
+static bool openSector(int sector, uint32_t sequence, uint32_t time) {
+  if (esp_partition_erase_range(surveyPartition, sectorAddress(sector), SURVEY_SECTOR_SIZE) != ESP_OK) {
+    return false;
+  }
+
+  SurveySectorHeader header;
+  header.magic = SURVEY_MAGIC;
+  header.sequence = sequence;
+  header.baseTime = time;
+  memset(header.bloom, 0xFF, sizeof(header.bloom));
+  if (esp_partition_write(surveyPartition, sectorAddress(sector), &header, sizeof(header)) != ESP_OK) {
+    return false;
+  }
+
+  sectorSeq[sector] = sequence;
+  sectorTime[sector] = time;
+  headSector = sector;
+  writeOffset = sizeof(SurveySectorHeader);
+  lastRecordTime = time;
+  headDict.count = 0;
+  memset(headBloom, 0xFF, sizeof(headBloom));
+  return true;
+}
+
+static bool openNextSector(uint32_t time) {
+  int next = (headSector + 1) % sectorCount;
+  return openSector(next, sectorSeq[headSector] + 1, time);
+}
+
+static bool appendRecord(const uint8_t* data, int len) {
+  if (esp_partition_write(surveyPartition, sectorAddress(headSector) + writeOffset, data, len) != ESP_OK) {
+    return false;
+  }
+  writeOffset += len;
+  return true;
+}
+
+static void markBloom(const uint8_t* mac) {
+  int bits[2];
+  bloomBits(mac, bits[0], bits[1]);
+  for (int i = 0; i < 2; i++) {
+    int byteIndex = bits[i] / 8;
+    uint8_t value = headBloom[byteIndex] & ~(1 << (bits[i] % 8));
+    if (value != headBloom[byteIndex]) {
+      headBloom[byteIndex] = value;
+      esp_partition_write(surveyPartition,
+                          sectorAddress(headSector) + offsetof(SurveySectorHeader, bloom) + byteIndex,
+                          &value, 1);
+    }
+  }
+}
+
+static int findId(const uint8_t* mac) {
+  for (int i = 0; i < headDict.count; i++) {
+    if (memcmp(headDict.bssid[i], mac, 6) == 0) return i;
+  }
+  return -1;
+}
+
+bool surveyBegin() {
+  if (surveyPartition) return true;
+
+  surveyPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                             (esp_partition_subtype_t)SURVEY_PARTITION_SUBTYPE,
+                                             SURVEY_PARTITION_LABEL);
+  if (!surveyPartition) return false;
+
+  sectorCount = min((int)(surveyPartition->size / SURVEY_SECTOR_SIZE), SURVEY_MAX_SECTORS);
+  headSector = -1;
+
+  for (int i = 0; i < sectorCount; i++) {
+    SurveySectorHeader header;
+    sectorSeq[i] = 0;
+    if (esp_partition_read(surveyPartition, sectorAddress(i), &header, sizeof(header)) != ESP_OK ||
+        header.magic != SURVEY_MAGIC) {
+      continue;
+    }
+    sectorSeq[i] = header.sequence;
+    sectorTime[i] = header.baseTime;
+    if (headSector < 0 || header.sequence > sectorSeq[headSector]) {
+      headSector = i;
+      memcpy(headBloom, header.bloom, sizeof(headBloom));
+    }
+  }
+
+  if (headSector < 0) {
+    if (!openSector(0, 1, 0)) {
+      surveyPartition = nullptr;
+      return false;
+    }
+  } else {
+    uint32_t end;
+    if (decodeSector(headSector, headDict, lastRecordTime, end, nullptr)) {
+      writeOffset = end;
+    } else {
+      // Torn write at power loss: leave the tail alone, start fresh
+      writeOffset = SURVEY_SECTOR_SIZE;
+    }
+  }
+
+  // The survey clock has no RTC behind it, so it carries on from the last
+  // record across reboots. It counts from boot, not from this (lazy) mount.
+  bootBaseTime = lastRecordTime + 1;
+
+  uint8_t record[6];
+  record[0] = TAG_BOOT;
+  int len = 1 + putVarint(record + 1, bootBaseTime - lastRecordTime);
+  if (writeOffset + len > SURVEY_SECTOR_SIZE) {
+    openNextSector(bootBaseTime);
+    len = 1 + putVarint(record + 1, 0);
+  }
+  if (appendRecord(record, len)) {
+    lastRecordTime = bootBaseTime;
+  }
+  return true;
+}
+
+uint32_t surveyNow() {
+  surveyBegin();  // the clock base comes from the log
+  return bootBaseTime + millis() / 1000;
+}
+
+void surveyRecordScan(int n) {
+  if (!surveyBegin() || n <= 0) return;
+  if (n > SURVEY_MAX_PER_SCAN) n = SURVEY_MAX_PER_SCAN;
+
+  uint32_t now = surveyNow();
+  uint8_t defs[SURVEY_MAX_PER_SCAN * 8];
+  uint8_t scan[12 + SURVEY_MAX_PER_SCAN * 8];
+  int ids[SURVEY_MAX_PER_SCAN];
+  int8_t rssi[SURVEY_MAX_PER_SCAN];
+
+  // Second attempt runs against a freshly opened sector
+  for (int attempt = 0; attempt < 2; attempt++) {
+    int defLen = 0;
+    int scanLen = 0;
+    int newIds = 0;
+
+    scan[scanLen++] = TAG_SCAN;
+    scanLen += putVarint(scan + scanLen, now - lastRecordTime);
+    scanLen += putVarint(scan + scanLen, n);
+
+    for (int i = 0; i < n; i++) {
+      const uint8_t* mac = WiFi.BSSID(i);
+      rssi[i] = constrain(WiFi.RSSI(i), -128, 0);
+      ids[i] = findId(mac);
+
+      int8_t previous = 0;
+      if (ids[i] < 0) {
+        ids[i] = headDict.count + newIds++;
+        defs[defLen++] = TAG_DEFINE;
+        memcpy(defs + defLen, mac, 6);
+        defLen += 6;
+        defs[defLen++] = WiFi.channel(i);
+      } else {
+        previous = headDict.lastRssi[ids[i]];
+      }
+
+      scanLen += putVarint(scan + scanLen, ids[i]);
+      scanLen += putVarint(scan + scanLen, zigzag(rssi[i] - previous));
+    }
+
+    if (headDict.count + newIds > SURVEY_MAX_IDS ||
+        writeOffset + defLen + scanLen > SURVEY_SECTOR_SIZE) {
+      if (attempt > 0 || !openNextSector(now)) return;
+      continue;
+    }
+
+    if (!appendRecord(defs, defLen) || !appendRecord(scan, scanLen)) return;
+
+    for (int i = 0; i < n; i++) {
+      int id = ids[i];
+      if (id >= headDict.count) {
+        memcpy(headDict.bssid[id], WiFi.BSSID(i), 6);
+        headDict.channel[id] = WiFi.channel(i);
+        markBloom(headDict.bssid[id]);
+      }
+      headDict.lastRssi[id] = rssi[i];
+    }
+    headDict.count += newIds;
+    lastRecordTime = now;
+    return;
+  }
+}
+
+void surveyQuery(const uint8_t* bssid, uint32_t from, uint32_t to, SurveyVisitor visit, void* ctx) {
+  if (!surveyBegin()) return;
+
+  SurveyFilter filter = { bssid, from, to, visit, ctx };
+
+  // Oldest sector first: walk the ring starting after the head
+  for (int step = 1; step <= sectorCount; step++) {
+    int sector = (headSector + step) % sectorCount;
+    if (sectorSeq[sector] == 0) continue;
+
+    // A sector covers time up to the start of the next written sector
+    uint32_t start = sectorTime[sector];
+    if (start > to) break;
+    if (sector != headSector) {
+      int next = (sector + 1) % sectorCount;
+      if (sectorSeq[next] == sectorSeq[sector] + 1 && sectorTime[next] < from) continue;
+    }
+
+    if (bssid) {
+      uint8_t bloom[SURVEY_BLOOM_BYTES];
+      if (sector == headSector) {
+        memcpy(bloom, headBloom, sizeof(bloom));
+      } else if (esp_partition_read(surveyPartition,
+                                    sectorAddress(sector) + offsetof(SurveySectorHeader, bloom),
+                                    bloom, sizeof(bloom)) != ESP_OK) {
+        continue;
+      }
+      if (!bloomContains(bloom, bssid)) continue;
+    }
+
+    uint32_t time, end;
+    decodeSector(sector, queryDict, time, end, &filter);
+  }
+}
+
+static void accumulateStats(const SurveyPoint& point, void* ctx) {
+  SurveyStats* stats = (SurveyStats*)ctx;
+  if (stats->samples == 0) {
+    stats->firstTime = point.time;
+    stats->minRssi = point.rssi;
+    stats->maxRssi = point.rssi;
+  }
+  stats->samples++;
+  stats->lastTime = point.time;
+  stats->sumRssi += point.rssi;
+  if (point.rssi < stats->minRssi) stats->minRssi = point.rssi;
+  if (point.rssi > stats->maxRssi) stats->maxRssi = point.rssi;
+}
+
+bool surveyStats(const uint8_t* bssid, uint32_t from, uint32_t to, SurveyStats& stats) {
+  memset(&stats, 0, sizeof(stats));
+  surveyQuery(bssid, from, to, accumulateStats, &stats);
+  return stats.samples > 0;
+}
+
+static void printPoint(const SurveyPoint& point, void* ctx) {
+  char line[48];
+  snprintf(line, sizeof(line), "%lu,%02x:%02x:%02x:%02x:%02x:%02x,%u,%d",
+           (unsigned long)point.time,
+           point.bssid[0], point.bssid[1], point.bssid[2],
+           point.bssid[3], point.bssid[4], point.bssid[5],
+           point.channel, point.rssi);
+  ((Print*)ctx)->println(line);
+}
+
+void surveyExport(Print& out, const uint8_t* bssid) {
+  out.println("time,bssid,channel,rssi");
+  surveyQuery(bssid, 0, 0xFFFFFFFF, printPoint, &out);
+}
+
+void surveyErase() {
+  if (!surveyBegin()) return;
+  uint32_t now = surveyNow();
+  esp_partition_erase_range(surveyPartition, 0, sectorAddress(sectorCount));
+  for (int i = 0; i < sectorCount; i++) {
+    sectorSeq[i] = 0;
+  }
+  openSector(0, 1, now);
+}
+
+uint32_t surveyUsedBytes() {
+  if (!surveyPartition) return 0;
+  uint32_t used = writeOffset;
+  for (int i = 0; i < sectorCount; i++) {
+    if (sectorSeq[i] != 0 && i != headSector) used += SURVEY_SECTOR_SIZE;
+  }
+  return used;
+}
+
+uint32_t surveyCapacityBytes() {
+  return surveyPartition ? sectorAddress(sectorCount) : 0;
+}
+
+// Called before a mode or the dashboard takes the radio: a scan still
+// running makes channel changes fail and would overlap a soft AP start
+void surveyCancelScan() {
+  if (surveyScanPending || WiFi.scanComplete() == WIFI_SCAN_RUNNING) {
+    esp_wifi_scan_stop();
+  }
+  WiFi.scanDelete();
+  surveyScanPending = false;
+}
+
+void updateBackgroundSurvey() {
+  // Kick off a scan every SURVEY_INTERVAL while the radio is free
+  bool idle = currentState != SCAN_MODE && currentState != PS_MODE &&
+              currentState != MITM_MODE && currentState != AP_MODE;
+  if (idle && !surveyScanPending && millis() - lastSurveyScan > SURVEY_INTERVAL) {
+    lastSurveyScan = millis();
+    wifiBegin();
+    surveyScanPending = WiFi.scanNetworks(true, true) == WIFI_SCAN_RUNNING;
+  }
+
+  if (surveyScanPending) {
+    int n = WiFi.scanComplete();
+    if (n >= 0) {
+      surveyRecordScan(n);
+      WiFi.scanDelete();
+      surveyScanPending = false;
+    } else if (n == WIFI_SCAN_FAILED) {
+      surveyScanPending = false;
+    }
+  }
+}
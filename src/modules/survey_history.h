@@ -0,0 +1,46 @@
+#ifndef SURVEY_HISTORY_H
+#define SURVEY_HISTORY_H
+
+#include "../core/globals.h"
+
+// Survey history lives in the "survey" data partition (see partitions.csv)
+#define SURVEY_PARTITION_LABEL "survey"
+#define SURVEY_PARTITION_SUBTYPE 0x40
+#define SURVEY_SECTOR_SIZE 4096
+#define SURVEY_MAX_SECTORS 256
+#define SURVEY_BLOOM_BYTES 32
+#define SURVEY_MAX_IDS 64
+#define SURVEY_MAX_PER_SCAN 32
+
+// One RSSI sample of one BSSID, time in survey clock seconds
+struct SurveyPoint {
+  uint32_t time;
+  uint8_t bssid[6];
+  uint8_t channel;
+  int8_t rssi;
+};
+
+struct SurveyStats {
+  uint32_t samples;
+  uint32_t firstTime;
+  uint32_t lastTime;
+  int8_t minRssi;
+  int8_t maxRssi;
+  int32_t sumRssi;
+};
+
+typedef void (*SurveyVisitor)(const SurveyPoint& point, void* ctx);
+
+bool surveyBegin();
+uint32_t surveyNow();
+void surveyRecordScan(int n);
+void surveyQuery(const uint8_t* bssid, uint32_t from, uint32_t to, SurveyVisitor visit, void* ctx);
+bool surveyStats(const uint8_t* bssid, uint32_t from, uint32_t to, SurveyStats& stats);
+void surveyExport(Print& out, const uint8_t* bssid);
+void surveyErase();
+uint32_t surveyUsedBytes();
+uint32_t surveyCapacityBytes();
+void updateBackgroundSurvey();
+void surveyCancelScan();
+
+#endif
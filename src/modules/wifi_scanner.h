@@ -3,8 +3,10 @@
 
 #include "../core/globals.h"
 
+void wifiBegin();
 void processScanResults(int n);
 void enterScanMode();
+void updateScanMode();
 void enterSelectMode();
 void enterInfoMode();
 void enterAttackMode();
@@ -1,4 +1,7 @@
 #include "lcd_handler.h"
+#include "../modules/packet_analyzer.h"
+#include "../modules/survey_history.h"
+#include "../input/input_trace.h"
 
 void showMainMenu() {
   lcd.clear();
@@ -36,8 +39,9 @@ void showScanResults() {
   
   lcd.print("Found:");
   lcd.setCursor(0, 1);
-  lcd.print(String(networkCount) + " networks");
-  delay(2000);
+  lcd.print(networkCount);
+  lcd.print(" networks");
+  uiPause(2000);
   currentState = MAIN_MENU;
   showMainMenu();
 }
@@ -48,14 +52,12 @@ void showSelectScreen() {
   
   if (networkCount > 0) {
     lcd.setCursor(0, 1);
-    String displayText = networks[scrollPos].ssid;
-    if (displayText.length() > 16) {
-      displayText = displayText.substring(0, 13) + "...";
-    }
+    int width = 16;
     if (scrollPos == selectedNetwork) {
-      displayText = ">" + displayText;
+      lcd.print(">");
+      width--;
     }
-    lcd.print(displayText);
+    printEllipsized(networks[scrollPos].ssid.view(), width);
   } else {
     lcd.setCursor(0, 1);
     lcd.print("No networks");
@@ -72,37 +74,61 @@ void showInfoScreen() {
     return;
   }
   
-  WiFiNetwork net = networks[selectedNetwork];
+  const WiFiNetwork& net = networks[selectedNetwork];
   
   switch(infoPage) {
     case 0:  // SSID
       lcd.setCursor(0, 0);
       lcd.print("SSID:");
       lcd.setCursor(0, 1);
-      lcd.print(net.ssid);
+      lcd.print(net.ssid.c_str());
       break;
       
     case 1:  // Technical details
       lcd.setCursor(0, 0);
-      lcd.print("RSSI:" + String(net.rssi) + "dB");
+      lcd.print("RSSI:");
+      lcd.print(net.rssi);
+      lcd.print("dB");
       lcd.setCursor(0, 1);
-      lcd.print("Ch:" + String(net.channel) + " Bw:" + getBandwidth(net));
+      lcd.print("Ch:");
+      lcd.print(net.channel);
+      lcd.print(" Bw:");
+      lcd.print(getBandwidth(net));
       break;
       
     case 2:  // MAC and security
       lcd.setCursor(0, 0);
-      lcd.print("MAC:" + net.bssid.substring(0, 13));
+      lcd.print("MAC:");
+      lcd.print(net.bssid.view().substr(0, 13));
       lcd.setCursor(0, 1);
-      lcd.print("Sec:" + net.encryption.substring(0, 12));
+      lcd.print("Sec:");
+      lcd.print(StrView(net.encryption).substr(0, 12));
+      break;
+      
+    case 3: {  // Survey history over the last 24 hours
+      uint8_t mac[6];
+      parseMacAddress(net.bssid.c_str(), mac);
+      uint32_t now = surveyNow();
+      SurveyStats stats;
+      lcd.setCursor(0, 0);
+      if (surveyStats(mac, (now > 86400) ? now - 86400 : 0, now, stats)) {
+        lcd.print("Hist:");
+        lcd.print(stats.samples);
+        lcd.setCursor(0, 1);
+        lcd.printf("%d/%ld/%ddB", stats.minRssi, (long)(stats.sumRssi / (int32_t)stats.samples), stats.maxRssi);
+      } else {
+        lcd.print("No history");
+      }
       break;
+    }
   }
   
   // Show page indicator
   lcd.setCursor(14, 0);
-  lcd.print(String(infoPage + 1) + "/" + String(INFO_PAGES));
+  lcd.printf("%d/%d", infoPage + 1, INFO_PAGES);
 }
 
-String getEncryptionType(wifi_auth_mode_t type) {
+const char* getEncryptionType(wifi_auth_mode_t type) {
   switch (type) {
     case WIFI_AUTH_OPEN: return "OPEN";
     case WIFI_AUTH_WEP: return "WEP";
@@ -114,10 +140,20 @@ String getEncryptionType(wifi_auth_mode_t type) {
   }
 }
 
-String getBandwidth(const WiFiNetwork& net) {
+const char* getBandwidth(const WiFiNetwork& net) {
   return (net.channel > 14) ? "5GHz" : "2.4GHz";
 }
 
+// Print text cut to width, ending in "..." when it does not fit
+void printEllipsized(StrView text, int width) {
+  if ((int)text.length() > width) {
+    lcd.print(text.substr(0, width - 3));
+    lcd.print("...");
+  } else {
+    lcd.print(text);
+  }
+}
+
 void showAttackMenu() {
   lcd.clear();
   lcd.setCursor(0, 0);
@@ -134,3 +170,51 @@ void showAttackMenu() {
     lcd.print(" ");
   }
 }
+
+void showDiagScreen() {
+  lcd.clear();
+  
+  switch(diagPage) {
+    case 0:  // Free heap and fragmentation
+      lcd.printf("Heap:%lu", (unsigned long)heapStats.freeBytes);
+      lcd.setCursor(0, 1);
+      lcd.printf("Max:%lu F:%u%%", (unsigned long)heapStats.largestBlock, heapStats.fragmentation);
+      break;
+      
+    case 1:  // Allocation counts
+      lcd.printf("Blk:%lu %+ld", (unsigned long)heapStats.allocatedBlocks, (long)heapStats.blockGrowth);
+      lcd.setCursor(0, 1);
+      lcd.printf("Fail:%lu", (unsigned long)heapStats.failedAllocs);
+      break;
+      
+    case 2: {  // Long-run watermarks
+      unsigned long up = millis() / 1000;
+      lcd.printf("Up:%luh%02lum", up / 3600, (up / 60) % 60);
+      lcd.setCursor(0, 1);
+      lcd.printf("Min:%lu", (unsigned long)heapStats.minFreeBytes);
+      break;
+    }
+      
+    case 3:  // Boot timing, "-" until reached
+      lcd.print(bootTiming.resumed ? "Boot:resumed" : "Boot:menu");
+      lcd.setCursor(0, 1);
+      if (bootTiming.firstFrame) {
+        lcd.printf("F:%lu", (unsigned long)bootTiming.firstFrame);
+      } else {
+        lcd.print("F:-");
+      }
+      if (bootTiming.firstCapture) {
+        lcd.printf(" C:%lu", (unsigned long)bootTiming.firstCapture);
+      } else {
+        lcd.print(" C:-");
+      }
+      break;
+  }
+}
+
+// Hold a message on screen; skipped while replaying a trace so replay
+// latencies measure the UI code, not the pauses
+void uiPause(unsigned long ms) {
+  if (replayActive()) return;
+  delay(ms);
+}
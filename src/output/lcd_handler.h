@@ -8,7 +8,10 @@ void showScanResults();
 void showSelectScreen();
 void showInfoScreen();
 void showAttackMenu();
-String getEncryptionType(wifi_auth_mode_t type);
-String getBandwidth(const WiFiNetwork& net);
+void showDiagScreen();
+const char* getEncryptionType(wifi_auth_mode_t type);
+const char* getBandwidth(const WiFiNetwork& net);
+void printEllipsized(StrView text, int width);
+void uiPause(unsigned long ms);
 
 #endif
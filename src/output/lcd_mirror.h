@@ -0,0 +1,56 @@
+#ifndef LCD_MIRROR_H
+#define LCD_MIRROR_H
+
+#include <LiquidCrystal.h>
+
+#define LCD_COLS 16
+#define LCD_ROWS 2
+
+// LiquidCrystal that keeps a copy of the visible characters, so the
+// current screen can be read back (input trace replay prints it)
+class LcdMirror : public LiquidCrystal {
+ public:
+  LcdMirror(uint8_t rs, uint8_t enable, uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3)
+    : LiquidCrystal(rs, enable, d0, d1, d2, d3) {
+    blank();
+  }
+
+  void clear() {
+    LiquidCrystal::clear();
+    blank();
+  }
+
+  void setCursor(uint8_t col, uint8_t row) {
+    LiquidCrystal::setCursor(col, row);
+    cursorCol = col;
+    cursorRow = row;
+  }
+
+  size_t write(uint8_t value) override {
+    if (cursorRow < LCD_ROWS && cursorCol < LCD_COLS) {
+      screen[cursorRow][cursorCol] = value;
+    }
+    cursorCol++;
+    return LiquidCrystal::write(value);
+  }
+
+  using Print::write;
+
+  const char* line(uint8_t row) const { return screen[row < LCD_ROWS ? row : 0]; }
+
+ private:
+  void blank() {
+    for (int r = 0; r < LCD_ROWS; r++) {
+      memset(screen[r], ' ', LCD_COLS);
+      screen[r][LCD_COLS] = '\0';
+    }
+    cursorCol = 0;
+    cursorRow = 0;
+  }
+
+  char screen[LCD_ROWS][LCD_COLS + 1];
+  uint8_t cursorCol;
+  uint8_t cursorRow;
+};
+
+#endif
@@ -0,0 +1,599 @@
+// Host-side merge of captures from several sensors.
+//
+// Each input is a pcap file (802.11 or radiotap link type) recorded by one
+// sensor. Inputs are decoded in parallel, one thread per sensor, and
+// merged by timestamp with a k-way heap merge. A frame that several
+// sensors captured within the dedupe window is counted once. The result
+// is a per-BSSID and a per-channel table in CSV.
+//
+// Memory use is bounded by the queue depth, the dedupe window and the
+// number of distinct BSSIDs, not by input size, so multi-GB captures
+// stream through.
+//
+// Frames are decoded with src/core/frame_decoder.h, the same code the
+// firmware uses. A trailing FCS is stripped: radiotap input says when
+// there is one, raw 802.11 input is checked against the CRC.
+//
+// Decoding runs one thread per input file, so it uses as many cores as
+// there are sensors. A single large capture is decoded on one core.
+//
+// Build: make -C tools sensor_merge/sensor_merge
+// Usage: sensor_merge [-w window_ms] [-q batches] [-o prefix] [name=]capture.pcap ...
+
+#include "../../src/core/frame_decoder.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const uint32_t LINKTYPE_IEEE802_11 = 105;
+const uint32_t LINKTYPE_RADIOTAP = 127;
+const uint32_t MAX_RECORD_LEN = 262144;
+const size_t BATCH_SIZE = 512;
+const int MAX_SENSORS = 64;
+
+typedef std::array<uint8_t, 6> Mac;
+
+// One decoded frame, self-contained so it can leave the reader thread
+struct Observation {
+  int64_t timeUs;
+  uint64_t hash;
+  uint32_t length;
+  uint16_t sensor;
+  uint8_t type;
+  uint8_t subtype;
+  bool retry;
+  bool hasBssid;
+  bool hasRssi;
+  int8_t rssi;
+  uint8_t channel;
+  uint8_t beaconChannel;
+  uint8_t ssidLen;
+  Mac bssid;
+  char ssid[32];
+};
+
+typedef std::vector<Observation> Batch;
+
+// Bounded blocking queue of batches between a reader and the merger
+class BatchQueue {
+ public:
+  explicit BatchQueue(size_t capacity) : capacity(capacity) {}
+
+  void push(Batch&& batch) {
+    std::unique_lock<std::mutex> lock(mutex);
+    notFull.wait(lock, [this] { return items.size() < capacity; });
+    items.push_back(std::move(batch));
+    notEmpty.notify_one();
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    notEmpty.notify_one();
+  }
+
+  // Returns false once the queue is closed and drained
+  bool pop(Batch& batch) {
+    std::unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+    if (items.empty()) return false;
+    batch = std::move(items.front());
+    items.pop_front();
+    notFull.notify_one();
+    return true;
+  }
+
+ private:
+  size_t capacity;
+  bool closed = false;
+  std::deque<Batch> items;
+  std::mutex mutex;
+  std::condition_variable notEmpty;
+  std::condition_variable notFull;
+};
+
+struct Sensor {
+  std::string name;
+  std::string path;
+  std::unique_ptr<BatchQueue> queue;
+  uint64_t frames = 0;
+  uint64_t skipped = 0;
+  std::string error;
+
+  // Merge cursor
+  Batch current;
+  size_t pos = 0;
+};
+
+uint32_t swap32(uint32_t v) {
+  return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+uint16_t le16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+uint32_t le32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+// CRC-32 as used for the 802.11 FCS
+uint32_t crc32(const uint8_t* data, size_t len) {
+  static uint32_t table[256];
+  static std::once_flag built;
+  std::call_once(built, [] {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      table[i] = c;
+    }
+  });
+  uint32_t crc = 0xFFFFFFFFu;
+  for (size_t i = 0; i < len; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+// Raw 802.11 captures do not say whether frames end in an FCS; a valid
+// CRC over the rest of the frame says it does
+bool endsInFcs(const uint8_t* frame, size_t len) {
+  if (len < 14) return false;
+  return crc32(frame, len - 4) == le32(frame + len - 4);
+}
+
+uint64_t fnv1a(const uint8_t* data, size_t len) {
+  uint64_t h = 1469598103934665603ULL;
+  for (size_t i = 0; i < len; i++) {
+    h = (h ^ data[i]) * 1099511628211ULL;
+  }
+  return h;
+}
+
+uint8_t frequencyToChannel(uint16_t mhz) {
+  if (mhz == 2484) return 14;
+  if (mhz >= 2412 && mhz <= 2472) return (mhz - 2407) / 5;
+  if (mhz >= 5000 && mhz <= 5900) return (mhz - 5000) / 5;
+  return 0;
+}
+
+struct RadioInfo {
+  bool hasRssi = false;
+  int8_t rssi = 0;
+  uint8_t channel = 0;
+  bool hasFcs = false;
+};
+
+// Parses the radiotap fields we need (flags, channel, antenna signal).
+// Returns the header length, or 0 if the header is malformed.
+size_t parseRadiotap(const uint8_t* data, size_t len, RadioInfo& radio) {
+  if (len < 8 || data[0] != 0) return 0;
+  size_t headerLen = le16(data + 2);
+  if (headerLen < 8 || headerLen > len) return 0;
+
+  // Skip the chain of present words; fields start after the last one
+  size_t presentEnd = 4;
+  uint32_t present = le32(data + 4);
+  uint32_t word = present;
+  while (word & 0x80000000u) {
+    presentEnd += 4;
+    if (presentEnd + 4 > headerLen) return 0;
+    word = le32(data + presentEnd);
+  }
+  size_t pos = presentEnd + 4;
+
+  // (alignment, size) of fields 0..5: TSFT, flags, rate, channel, FHSS, dBm signal
+  static const uint8_t align[6] = { 8, 1, 1, 2, 1, 1 };
+  static const uint8_t size[6] = { 8, 1, 1, 4, 2, 1 };
+  for (int bit = 0; bit < 6; bit++) {
+    if (!(present & (1u << bit))) continue;
+    pos = (pos + align[bit] - 1) & ~(size_t)(align[bit] - 1);
+    if (pos + size[bit] > headerLen) return headerLen;
+    if (bit == 1) radio.hasFcs = data[pos] & 0x10;
+    if (bit == 3) radio.channel = frequencyToChannel(le16(data + pos));
+    if (bit == 5) {
+      radio.hasRssi = true;
+      radio.rssi = (int8_t)data[pos];
+    }
+    pos += size[bit];
+  }
+  return headerLen;
+}
+
+void readSensor(Sensor& sensor, uint16_t index) {
+  FILE* f = fopen(sensor.path.c_str(), "rb");
+  if (!f) {
+    sensor.error = "cannot open";
+    sensor.queue->close();
+    return;
+  }
+  std::vector<char> fileBuffer(1 << 20);
+  setvbuf(f, fileBuffer.data(), _IOFBF, fileBuffer.size());
+
+  uint8_t global[24];
+  if (fread(global, 1, sizeof(global), f) != sizeof(global)) {
+    sensor.error = "short pcap header";
+    fclose(f);
+    sensor.queue->close();
+    return;
+  }
+
+  uint32_t magic = le32(global);
+  bool swapped = false;
+  bool nanos = false;
+  if (magic == 0xA1B2C3D4 || magic == 0xA1B23C4D) {
+    nanos = magic == 0xA1B23C4D;
+  } else if (magic == 0xD4C3B2A1 || magic == 0x4D3CB2A1) {
+    swapped = true;
+    nanos = magic == 0x4D3CB2A1;
+  } else {
+    sensor.error = "not a pcap file";
+    fclose(f);
+    sensor.queue->close();
+    return;
+  }
+  auto u32 = [swapped](const uint8_t* p) { return swapped ? swap32(le32(p)) : le32(p); };
+  uint32_t linkType = u32(global + 20) & 0xFFFF;
+  if (linkType != LINKTYPE_IEEE802_11 && linkType != LINKTYPE_RADIOTAP) {
+    sensor.error = "unsupported link type " + std::to_string(linkType);
+    fclose(f);
+    sensor.queue->close();
+    return;
+  }
+
+  std::vector<uint8_t> record(MAX_RECORD_LEN);
+  Batch batch;
+  batch.reserve(BATCH_SIZE);
+  uint8_t header[16];
+
+  while (fread(header, 1, sizeof(header), f) == sizeof(header)) {
+    uint32_t seconds = u32(header);
+    uint32_t fraction = u32(header + 4);
+    uint32_t captured = u32(header + 8);
+    if (captured > MAX_RECORD_LEN) {
+      sensor.error = "corrupt record length";
+      break;
+    }
+    if (fread(record.data(), 1, captured, f) != captured) break;
+
+    const uint8_t* frame = record.data();
+    size_t frameLen = captured;
+    RadioInfo radio;
+    if (linkType == LINKTYPE_RADIOTAP) {
+      size_t radiotapLen = parseRadiotap(frame, frameLen, radio);
+      if (radiotapLen == 0) {
+        sensor.skipped++;
+        continue;
+      }
+      frame += radiotapLen;
+      frameLen -= radiotapLen;
+      if (radio.hasFcs && frameLen >= 4) frameLen -= 4;
+    } else if (endsInFcs(frame, frameLen)) {
+      // Keep the FCS out of the dedupe hash and the IE parser
+      frameLen -= 4;
+    }
+
+    FrameInfo info;
+    if (!decodeFrame(frame, frameLen, info)) {
+      sensor.skipped++;
+      continue;
+    }
+
+    Observation obs;
+    memset(&obs, 0, sizeof(obs));
+    obs.timeUs = (int64_t)seconds * 1000000 + (nanos ? fraction / 1000 : fraction);
+    obs.hash = fnv1a(frame, frameLen);
+    obs.length = frameLen;
+    obs.sensor = index;
+    obs.type = info.type;
+    obs.subtype = info.subtype;
+    obs.retry = info.retry;
+    obs.hasRssi = radio.hasRssi;
+    obs.rssi = radio.rssi;
+    obs.channel = radio.channel;
+    obs.beaconChannel = info.channel;
+    if (info.bssid) {
+      obs.hasBssid = true;
+      memcpy(obs.bssid.data(), info.bssid, 6);
+    }
+    if (info.ssid) {
+      obs.ssidLen = info.ssidLen;
+      memcpy(obs.ssid, info.ssid, info.ssidLen);
+    }
+
+    batch.push_back(obs);
+    sensor.frames++;
+    if (batch.size() == BATCH_SIZE) {
+      sensor.queue->push(std::move(batch));
+      batch = Batch();
+      batch.reserve(BATCH_SIZE);
+    }
+  }
+
+  if (!batch.empty()) sensor.queue->push(std::move(batch));
+  fclose(f);
+  sensor.queue->close();
+}
+
+// Remembers recent frame hashes and which sensors reported them
+class DedupeWindow {
+ public:
+  explicit DedupeWindow(int64_t windowUs) : windowUs(windowUs) {}
+
+  // True when another sensor already reported this frame in the window
+  bool isDuplicate(const Observation& obs) {
+    while (!order.empty() && order.front().first < obs.timeUs - windowUs) {
+      auto it = seen.find(order.front().second);
+      if (it != seen.end() && it->second.timeUs == order.front().first) seen.erase(it);
+      order.pop_front();
+    }
+
+    uint64_t bit = 1ULL << obs.sensor;
+    auto it = seen.find(obs.hash);
+    if (it != seen.end() && !(it->second.sensors & bit)) {
+      it->second.sensors |= bit;
+      return true;
+    }
+
+    // New frame, or the same sensor captured it again
+    Entry& entry = seen[obs.hash];
+    entry.timeUs = obs.timeUs;
+    entry.sensors = bit;
+    order.emplace_back(obs.timeUs, obs.hash);
+    return false;
+  }
+
+ private:
+  struct Entry {
+    int64_t timeUs;
+    uint64_t sensors;
+  };
+
+  int64_t windowUs;
+  std::unordered_map<uint64_t, Entry> seen;
+  std::deque<std::pair<int64_t, uint64_t>> order;
+};
+
+struct BssidStats {
+  uint64_t frames = 0;
+  uint64_t beacons = 0;
+  uint64_t data = 0;
+  uint64_t retries = 0;
+  uint64_t bytes = 0;
+  uint64_t duplicates = 0;
+  uint64_t sensors = 0;
+  uint64_t rssiCount = 0;
+  int64_t rssiSum = 0;
+  int rssiMin = 0;
+  int rssiMax = 0;
+  uint8_t channel = 0;
+  std::string ssid;
+  int64_t firstUs = 0;
+  int64_t lastUs = 0;
+};
+
+struct ChannelStats {
+  uint64_t frames = 0;
+  uint64_t duplicates = 0;
+  uint64_t bytes = 0;
+  uint64_t beacons = 0;
+};
+
+std::string macString(const Mac& mac) {
+  char buf[18];
+  snprintf(buf, sizeof(buf), "%02x:%02x:%02x:%02x:%02x:%02x",
+           mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  return buf;
+}
+
+std::string csvQuote(const std::string& s) {
+  std::string out = "\"";
+  for (char c : s) {
+    if (c == '"') out += '"';
+    out += ((unsigned char)c < 0x20) ? '?' : c;
+  }
+  return out + "\"";
+}
+
+void usage() {
+  fprintf(stderr,
+          "usage: sensor_merge [-w window_ms] [-q batches] [-o prefix] [name=]capture.pcap ...\n"
+          "  -w  dedupe window in milliseconds (default 20)\n"
+          "  -q  queue depth per sensor in batches of %zu frames (default 8)\n"
+          "  -o  write <prefix>_bssid.csv and <prefix>_channel.csv instead of stdout\n",
+          BATCH_SIZE);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int64_t windowUs = 20000;
+  size_t queueDepth = 8;
+  std::string outPrefix;
+  std::vector<Sensor> sensors;
+  sensors.reserve(MAX_SENSORS);
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if ((arg == "-w" || arg == "-q" || arg == "-o") && i + 1 < argc) {
+      std::string value = argv[++i];
+      if (arg == "-w") windowUs = (int64_t)(atof(value.c_str()) * 1000);
+      if (arg == "-q") queueDepth = std::max(1, atoi(value.c_str()));
+      if (arg == "-o") outPrefix = value;
+    } else if (arg == "-h" || arg == "--help" || arg[0] == '-') {
+      usage();
+      return arg[0] == '-' && arg != "-h" && arg != "--help" ? 2 : 0;
+    } else {
+      if (sensors.size() == (size_t)MAX_SENSORS) {
+        fprintf(stderr, "at most %d sensors\n", MAX_SENSORS);
+        return 2;
+      }
+      Sensor sensor;
+      size_t eq = arg.find('=');
+      sensor.name = (eq == std::string::npos) ? arg : arg.substr(0, eq);
+      sensor.path = (eq == std::string::npos) ? arg : arg.substr(eq + 1);
+      sensor.queue.reset(new BatchQueue(queueDepth));
+      sensors.push_back(std::move(sensor));
+    }
+  }
+  if (sensors.empty()) {
+    usage();
+    return 2;
+  }
+
+  auto started = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < sensors.size(); i++) {
+    readers.emplace_back(readSensor, std::ref(sensors[i]), (uint16_t)i);
+  }
+
+  // Heap of (timestamp of next frame, sensor); ties go to the lower sensor
+  typedef std::pair<int64_t, size_t> HeapItem;
+  std::priority_queue<HeapItem, std::vector<HeapItem>, std::greater<HeapItem>> heap;
+  auto refill = [&](size_t i) {
+    Sensor& s = sensors[i];
+    if (s.pos >= s.current.size()) {
+      s.current.clear();
+      s.pos = 0;
+      if (!s.queue->pop(s.current)) return;
+    }
+    heap.emplace(s.current[s.pos].timeUs, i);
+  };
+  for (size_t i = 0; i < sensors.size(); i++) refill(i);
+
+  DedupeWindow dedupe(windowUs);
+  std::map<Mac, BssidStats> bssids;
+  std::array<ChannelStats, 256> channels;
+  uint64_t merged = 0;
+  uint64_t duplicates = 0;
+  int64_t lastTime = INT64_MIN;
+  uint64_t outOfOrder = 0;
+
+  while (!heap.empty()) {
+    size_t i = heap.top().second;
+    heap.pop();
+    const Observation obs = sensors[i].current[sensors[i].pos++];
+    refill(i);
+
+    // Inputs are merged assuming each file is in time order
+    if (obs.timeUs < lastTime) outOfOrder++;
+    lastTime = std::max(lastTime, obs.timeUs);
+
+    bool duplicate = dedupe.isDuplicate(obs);
+    if (duplicate) {
+      duplicates++;
+    } else {
+      merged++;
+    }
+
+    BssidStats* stats = nullptr;
+    if (obs.hasBssid) {
+      stats = &bssids[obs.bssid];
+      stats->sensors |= 1ULL << obs.sensor;
+      if (obs.hasRssi) {
+        if (stats->rssiCount == 0 || obs.rssi < stats->rssiMin) stats->rssiMin = obs.rssi;
+        if (stats->rssiCount == 0 || obs.rssi > stats->rssiMax) stats->rssiMax = obs.rssi;
+        stats->rssiSum += obs.rssi;
+        stats->rssiCount++;
+      }
+      if (obs.beaconChannel) stats->channel = obs.beaconChannel;
+      if (obs.ssidLen && stats->ssid.empty()) stats->ssid.assign(obs.ssid, obs.ssidLen);
+    }
+
+    uint8_t channel = obs.channel ? obs.channel : obs.beaconChannel;
+    if (!channel && stats) channel = stats->channel;
+    ChannelStats& ch = channels[channel];
+
+    if (duplicate) {
+      ch.duplicates++;
+      if (stats) stats->duplicates++;
+      continue;
+    }
+
+    bool beacon = obs.type == FRAME_TYPE_MGMT && obs.subtype == MGMT_SUBTYPE_BEACON;
+    ch.frames++;
+    ch.bytes += obs.length;
+    if (beacon) ch.beacons++;
+
+    if (stats) {
+      if (stats->frames == 0) stats->firstUs = obs.timeUs;
+      stats->lastUs = obs.timeUs;
+      stats->frames++;
+      stats->bytes += obs.length;
+      if (beacon) stats->beacons++;
+      if (obs.type == FRAME_TYPE_DATA) stats->data++;
+      if (obs.retry) stats->retries++;
+    }
+  }
+
+  for (auto& t : readers) t.join();
+
+  FILE* bssidOut = stdout;
+  FILE* channelOut = stdout;
+  if (!outPrefix.empty()) {
+    bssidOut = fopen((outPrefix + "_bssid.csv").c_str(), "w");
+    channelOut = fopen((outPrefix + "_channel.csv").c_str(), "w");
+    if (!bssidOut || !channelOut) {
+      fprintf(stderr, "cannot write %s_*.csv\n", outPrefix.c_str());
+      return 1;
+    }
+  }
+
+  fprintf(bssidOut, "bssid,ssid,channel,frames,beacons,data,retries,bytes,duplicates,"
+                    "sensors,rssi_min,rssi_avg,rssi_max,first_us,last_us\n");
+  std::array<uint32_t, 256> bssidsPerChannel = {};
+  for (const auto& entry : bssids) {
+    const BssidStats& s = entry.second;
+    bssidsPerChannel[s.channel]++;
+    fprintf(bssidOut, "%s,%s,%u,%llu,%llu,%llu,%llu,%llu,%llu,%d,",
+            macString(entry.first).c_str(), csvQuote(s.ssid).c_str(), s.channel,
+            (unsigned long long)s.frames, (unsigned long long)s.beacons,
+            (unsigned long long)s.data, (unsigned long long)s.retries,
+            (unsigned long long)s.bytes, (unsigned long long)s.duplicates,
+            __builtin_popcountll(s.sensors));
+    if (s.rssiCount) {
+      fprintf(bssidOut, "%d,%.1f,%d,", s.rssiMin, (double)s.rssiSum / s.rssiCount, s.rssiMax);
+    } else {
+      fprintf(bssidOut, ",,,");
+    }
+    fprintf(bssidOut, "%lld,%lld\n", (long long)s.firstUs, (long long)s.lastUs);
+  }
+
+  if (channelOut == bssidOut) fprintf(channelOut, "\n");
+  fprintf(channelOut, "channel,frames,beacons,bytes,duplicates,bssids\n");
+  for (size_t c = 0; c < channels.size(); c++) {
+    const ChannelStats& ch = channels[c];
+    if (ch.frames == 0 && ch.duplicates == 0) continue;
+    fprintf(channelOut, "%zu,%llu,%llu,%llu,%llu,%u\n", c,
+            (unsigned long long)ch.frames, (unsigned long long)ch.beacons,
+            (unsigned long long)ch.bytes, (unsigned long long)ch.duplicates,
+            bssidsPerChannel[c]);
+  }
+
+  if (bssidOut != stdout) fclose(bssidOut);
+  if (channelOut != stdout) fclose(channelOut);
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  int status = 0;
+  for (const Sensor& s : sensors) {
+    fprintf(stderr, "%s: %llu frames, %llu skipped%s%s\n", s.name.c_str(),
+            (unsigned long long)s.frames, (unsigned long long)s.skipped,
+            s.error.empty() ? "" : ", error: ", s.error.c_str());
+    if (!s.error.empty()) status = 1;
+  }
+  fprintf(stderr, "%llu unique frames, %llu duplicates, %llu out of order, %.2fs (%.0f frames/s)\n",
+          (unsigned long long)merged, (unsigned long long)duplicates,
+          (unsigned long long)outOfOrder, seconds,
+          seconds > 0 ? (merged + duplicates) / seconds : 0.0);
+  return status;
+}
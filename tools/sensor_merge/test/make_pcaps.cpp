@@ -0,0 +1,187 @@
+// Writes the two small captures the sensor_merge test runs on.
+//
+// north.pcap: radiotap, little-endian, with channel, signal and a
+//   trailing FCS. Beacons of HomeNet (ch 6) and QoS data to it.
+// south.pcap: raw 802.11, big-endian headers, no radio info. The same
+//   HomeNet beacons 3 ms later (inside the dedupe window), Lab beacons
+//   (ch 11), and one data frame repeated 40 ms later (outside it). The
+//   beacons carry a valid FCS, the data frame does not.
+//
+// Generating the files keeps the fixture reviewable; expected.csv holds
+// the tables sensor_merge must produce from them.
+//
+// Usage: make_pcaps north.pcap south.pcap
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace {
+
+typedef std::vector<uint8_t> Bytes;
+
+const uint8_t HOME_AP[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x0a };
+const uint8_t LAB_AP[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x0b };
+const uint8_t STATION[6] = { 0x02, 0x00, 0x00, 0x00, 0x01, 0x01 };
+const uint8_t BROADCAST[6] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
+class PcapWriter {
+ public:
+  PcapWriter(const char* path, uint32_t linkType, bool bigEndian)
+      : f(fopen(path, "wb")), bigEndian(bigEndian) {
+    if (!f) return;
+    put32(0xA1B2C3D4);
+    put16(2);
+    put16(4);
+    put32(0);
+    put32(0);
+    put32(65535);
+    put32(linkType);
+  }
+  ~PcapWriter() {
+    if (f) fclose(f);
+  }
+
+  bool ok() const { return f != nullptr; }
+
+  void record(uint64_t timeUs, const Bytes& data) {
+    put32(timeUs / 1000000);
+    put32(timeUs % 1000000);
+    put32(data.size());
+    put32(data.size());
+    fwrite(data.data(), 1, data.size(), f);
+  }
+
+ private:
+  void put16(uint16_t v) {
+    uint8_t b[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+    if (bigEndian) std::swap(b[0], b[1]);
+    fwrite(b, 1, 2, f);
+  }
+  void put32(uint32_t v) {
+    uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) };
+    if (bigEndian) {
+      std::swap(b[0], b[3]);
+      std::swap(b[1], b[2]);
+    }
+    fwrite(b, 1, 4, f);
+  }
+
+  FILE* f;
+  bool bigEndian;
+};
+
+void append(Bytes& out, const uint8_t* data, size_t len) {
+  out.insert(out.end(), data, data + len);
+}
+
+void header(Bytes& out, uint8_t fc0, uint8_t fc1, const uint8_t* a1, const uint8_t* a2,
+            const uint8_t* a3, uint16_t seq) {
+  uint8_t start[4] = { fc0, fc1, 0, 0 };
+  append(out, start, 4);
+  append(out, a1, 6);
+  append(out, a2, 6);
+  append(out, a3, 6);
+  out.push_back((uint8_t)(seq << 4));
+  out.push_back((uint8_t)(seq >> 4));
+}
+
+Bytes beacon(const uint8_t* bssid, const char* ssid, uint8_t channel, uint16_t seq,
+             uint64_t tsf) {
+  Bytes out;
+  header(out, 0x80, 0x00, BROADCAST, bssid, bssid, seq);
+  for (int i = 0; i < 8; i++) out.push_back((uint8_t)(tsf >> (8 * i)));
+  uint8_t fixed[4] = { 0x64, 0x00, 0x11, 0x04 };  // 100 TU, ESS + privacy
+  append(out, fixed, 4);
+  out.push_back(0);
+  out.push_back((uint8_t)strlen(ssid));
+  append(out, (const uint8_t*)ssid, strlen(ssid));
+  uint8_t ds[3] = { 3, 1, channel };
+  append(out, ds, 3);
+  return out;
+}
+
+// QoS data from the station to the AP
+Bytes qosData(uint16_t seq, bool retry) {
+  Bytes out;
+  header(out, 0x88, retry ? 0x09 : 0x01, HOME_AP, STATION, HOME_AP, seq);
+  uint8_t qos[2] = { 0x00, 0x00 };
+  append(out, qos, 2);
+  uint8_t payload[16] = { 0xaa, 0xaa, 0x03, 0, 0, 0, 0x08, 0x00 };
+  payload[8] = (uint8_t)seq;
+  append(out, payload, sizeof(payload));
+  return out;
+}
+
+// Radiotap with flags (FCS present), channel and dBm signal, then the
+// frame and a 4 byte FCS that sensor_merge must strip
+Bytes radiotap(const Bytes& frame, uint16_t mhz, int8_t rssi) {
+  Bytes out = { 0, 0, 16, 0, 0x2a, 0, 0, 0 };  // version, pad, len 16, present 1|3|5
+  out.push_back(0x10);                          // flags: FCS at end
+  out.push_back(0);                             // pad to align channel
+  out.push_back((uint8_t)mhz);
+  out.push_back((uint8_t)(mhz >> 8));
+  out.push_back(0xa0);                          // channel flags: 2 GHz, CCK
+  out.push_back(0x00);
+  out.push_back((uint8_t)rssi);
+  out.push_back(0);                             // pad
+  append(out, frame.data(), frame.size());
+  uint8_t fcs[4] = { 0xde, 0xad, 0xbe, 0xef };
+  append(out, fcs, 4);
+  return out;
+}
+
+uint32_t crc32(const Bytes& data) {
+  uint32_t crc = 0xFFFFFFFFu;
+  for (uint8_t b : data) {
+    crc ^= b;
+    for (int k = 0; k < 8; k++) crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+  }
+  return ~crc;
+}
+
+Bytes withFcs(Bytes frame) {
+  uint32_t fcs = crc32(frame);
+  for (int i = 0; i < 4; i++) frame.push_back((uint8_t)(fcs >> (8 * i)));
+  return frame;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    fprintf(stderr, "usage: make_pcaps north.pcap south.pcap\n");
+    return 2;
+  }
+  PcapWriter north(argv[1], 127, false);
+  PcapWriter south(argv[2], 105, true);
+  if (!north.ok() || !south.ok()) {
+    fprintf(stderr, "cannot write captures\n");
+    return 1;
+  }
+
+  const uint64_t start = 1000000;
+  const uint64_t beaconUs = 102400;
+
+  // Frames go out in time order per file, interleaving beacons and data
+  for (int k = 0; k < 10; k++) {
+    uint64_t t = start + k * beaconUs;
+    Bytes home = beacon(HOME_AP, "HomeNet", 6, k, t);
+    north.record(t, radiotap(home, 2437, -40 - k % 3));
+
+    if (k < 5) {
+      Bytes data = qosData(100 + k, k == 3);
+      north.record(t + 50000, radiotap(data, 2437, -55));
+    }
+  }
+
+  for (int k = 0; k < 10; k++) {
+    uint64_t t = start + k * beaconUs;
+    south.record(t + 3000, withFcs(beacon(HOME_AP, "HomeNet", 6, k, t)));
+    south.record(t + 20000, withFcs(beacon(LAB_AP, "Lab", 11, 500 + k, t + 77)));
+    if (k == 2) south.record(t + 90000, qosData(102, false));
+  }
+  return 0;
+}
@@ -0,0 +1,127 @@
+// Stress test for the seqlock in src/core/snapshot.h.
+//
+// One writer publishes structs whose fields all hold the same counter;
+// several readers copy them as fast as they can. A copy with mixed
+// values is a torn read, and a counter going backwards means a reader saw
+// an older copy after a newer one. Either fails the test.
+//
+// On the host the writer and readers run on separate cores at the same
+// priority, which overlaps publishes and copies far more often than on
+// the device.
+//
+// Build: make -C tools snapshot_test/snapshot_test
+// Usage: snapshot_test [-r readers] [-n publishes]
+
+#include "../../src/core/snapshot.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Mixed field sizes, larger than a cache line, like CaptureStats
+struct Sample {
+  uint32_t a[12];
+  uint64_t b[6];
+  uint16_t c[8];
+  uint8_t d[5];
+};
+
+void fill(Sample& s, uint32_t n) {
+  for (auto& v : s.a) v = n;
+  for (auto& v : s.b) v = n;
+  for (auto& v : s.c) v = (uint16_t)n;
+  for (auto& v : s.d) v = (uint8_t)n;
+}
+
+// False if the fields do not all hold the same counter
+bool consistent(const Sample& s) {
+  uint32_t n = s.a[0];
+  for (auto v : s.a) if (v != n) return false;
+  for (auto v : s.b) if (v != n) return false;
+  for (auto v : s.c) if (v != (uint16_t)n) return false;
+  for (auto v : s.d) if (v != (uint8_t)n) return false;
+  return true;
+}
+
+struct ReaderResult {
+  uint64_t reads = 0;
+  uint64_t retries = 0;
+  uint64_t torn = 0;
+  uint64_t backwards = 0;
+};
+
+Snapshot<Sample> snapshot;
+std::atomic<bool> done(false);
+
+void reader(ReaderResult& result) {
+  uint32_t last = 0;
+  Sample s;
+  while (!done.load(std::memory_order_relaxed)) {
+    if (!snapshot.tryRead(s)) {
+      result.retries++;
+      continue;
+    }
+    result.reads++;
+    if (!consistent(s)) {
+      result.torn++;
+    } else if (s.a[0] < last) {
+      result.backwards++;
+    } else {
+      last = s.a[0];
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int readerCount = 4;
+  uint32_t publishes = 5000000;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+      readerCount = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      publishes = strtoul(argv[++i], nullptr, 10);
+    } else {
+      fprintf(stderr, "usage: snapshot_test [-r readers] [-n publishes]\n");
+      return 2;
+    }
+  }
+  if (readerCount < 1) readerCount = 1;
+
+  std::vector<ReaderResult> results(readerCount);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < readerCount; i++) {
+    readers.emplace_back(reader, std::ref(results[i]));
+  }
+
+  Sample next;
+  for (uint32_t n = 1; n <= publishes; n++) {
+    fill(next, n);
+    snapshot.publish(next);
+  }
+  done = true;
+  for (auto& t : readers) t.join();
+
+  ReaderResult total;
+  for (const ReaderResult& r : results) {
+    total.reads += r.reads;
+    total.retries += r.retries;
+    total.torn += r.torn;
+    total.backwards += r.backwards;
+  }
+
+  bool ok = total.torn == 0 && total.backwards == 0 && snapshot.version() == publishes &&
+            consistent(snapshot.read()) && snapshot.read().a[0] == publishes;
+  printf("snapshot: %lu publishes, %d readers, %llu reads, %llu retries, %llu torn, "
+         "%llu backwards, %s\n",
+         (unsigned long)publishes, readerCount, (unsigned long long)total.reads,
+         (unsigned long long)total.retries, (unsigned long long)total.torn,
+         (unsigned long long)total.backwards, ok ? "ok" : "FAILED");
+  return ok ? 0 : 1;
+}
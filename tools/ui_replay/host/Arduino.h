@@ -0,0 +1,74 @@
+// Minimal Arduino core for running the UI code on a host; only what the
+// files linked by ui_replay use. Definitions are in host_arduino.cpp.
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <string>
+
+#define INPUT 0
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+int analogRead(int pin);
+int digitalRead(int pin);
+void pinMode(int pin, int mode);
+
+template <class T> T min(T a, T b) { return a < b ? a : b; }
+template <class T> T max(T a, T b) { return a > b ? a : b; }
+
+class String {
+ public:
+  String(const char* c = "") : s(c ? c : "") {}
+  const char* c_str() const { return s.c_str(); }
+  unsigned length() const { return s.size(); }
+
+ private:
+  std::string s;
+};
+
+class Print;
+
+class Printable {
+ public:
+  virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n);
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v) { return printf("%d", v); }
+  size_t print(unsigned v) { return printf("%u", v); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t print(unsigned long v) { return printf("%lu", v); }
+  size_t print(const Printable& p) { return p.printTo(*this); }
+  size_t println(const char* s = "") { return print(s) + print('\n'); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {};
+
+class HardwareSerial : public Stream {
+ public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { return fwrite(&c, 1, 1, stdout); }
+  using Print::write;
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+ public:
+  uint32_t getFreeHeap() { return 200000; }
+};
+extern EspClass ESP;
@@ -0,0 +1,8 @@
+#pragma once
+#include "Arduino.h"
+
+class IPAddress {
+ public:
+  IPAddress() {}
+  IPAddress(int, int, int, int) {}
+};
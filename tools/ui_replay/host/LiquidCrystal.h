@@ -0,0 +1,13 @@
+#pragma once
+#include "Arduino.h"
+
+// Headless display; LcdMirror keeps the visible text
+class LiquidCrystal : public Print {
+ public:
+  LiquidCrystal(uint8_t, uint8_t, uint8_t, uint8_t, uint8_t, uint8_t) {}
+  void begin(int, int) {}
+  void clear() {}
+  void setCursor(uint8_t, uint8_t) {}
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+};
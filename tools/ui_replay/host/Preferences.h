@@ -0,0 +1,26 @@
+#pragma once
+#include "Arduino.h"
+#include <map>
+
+// NVS namespace kept in memory for the lifetime of the process
+class Preferences {
+ public:
+  bool begin(const char*, bool = false) { return true; }
+  size_t putUChar(const char* key, uint8_t v) { return put(key, std::to_string(v)); }
+  size_t putBool(const char* key, bool v) { return put(key, v ? "1" : "0"); }
+  size_t putInt(const char* key, int32_t v) { return put(key, std::to_string(v)); }
+  size_t putString(const char* key, const char* v) { return put(key, v); }
+  uint8_t getUChar(const char* key, uint8_t def = 0) { return isKey(key) ? atoi(values[key].c_str()) : def; }
+  bool getBool(const char* key, bool def = false) { return isKey(key) ? values[key] == "1" : def; }
+  int32_t getInt(const char* key, int32_t def = 0) { return isKey(key) ? atoi(values[key].c_str()) : def; }
+  size_t getString(const char* key, char* buf, size_t len);
+  bool isKey(const char* key) { return values.count(key) > 0; }
+  bool remove(const char* key) { return values.erase(key) > 0; }
+
+ private:
+  size_t put(const char* key, const std::string& v) {
+    values[key] = v;
+    return v.size();
+  }
+  std::map<std::string, std::string> values;
+};
@@ -0,0 +1,10 @@
+#pragma once
+#include "WiFi.h"
+
+class WebServer {
+ public:
+  explicit WebServer(int) {}
+  void begin() {}
+  void stop() {}
+  void handleClient() {}
+};
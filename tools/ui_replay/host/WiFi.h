@@ -0,0 +1,43 @@
+#pragma once
+#include "Arduino.h"
+#include "IPAddress.h"
+#include "esp_wifi.h"
+
+#define WIFI_OFF 0
+#define WIFI_STA 1
+#define WIFI_AP 2
+#define WIFI_AP_STA 3
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+class WiFiClient : public Stream {
+ public:
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+};
+
+// Radio with a fixed set of networks; scans finish on the next
+// scanComplete() call
+class WiFiClass {
+ public:
+  bool mode(int m) { currentMode = m; return true; }
+  int getMode() { return currentMode; }
+  bool disconnect(bool = false) { return true; }
+  int16_t scanNetworks(bool = false, bool = false);
+  int16_t scanComplete();
+  void scanDelete() { scanning = false; }
+  String SSID(uint8_t i);
+  int32_t RSSI(uint8_t i);
+  int32_t channel(uint8_t i);
+  uint8_t* BSSID(uint8_t i);
+  wifi_auth_mode_t encryptionType(uint8_t i);
+  bool softAP(const char*, const char* = nullptr, int = 1) { return true; }
+  bool softAPdisconnect(bool = false) { return true; }
+  bool softAPConfig(IPAddress, IPAddress, IPAddress) { return true; }
+  uint8_t softAPgetStationNum() { return 0; }
+
+ private:
+  int currentMode = WIFI_OFF;
+  bool scanning = false;
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,84 @@
+// Definitions behind the host stubs in this directory
+#include "Arduino.h"
+#include "WiFi.h"
+#include "Preferences.h"
+#include <stdarg.h>
+#include <chrono>
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+
+static const auto start = std::chrono::steady_clock::now();
+static unsigned long delayedUs = 0;
+
+// delay() returns at once but moves the clock, so timeouts still expire
+unsigned long micros() {
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + delayedUs;
+}
+
+unsigned long millis() {
+  return micros() / 1000;
+}
+
+void delay(unsigned long ms) {
+  delayedUs += ms * 1000;
+}
+
+// Joystick centred, button released
+int analogRead(int) { return 2048; }
+int digitalRead(int) { return HIGH; }
+void pinMode(int, int) {}
+
+size_t Print::write(const uint8_t* buf, size_t n) {
+  for (size_t i = 0; i < n; i++) write(buf[i]);
+  return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0) return 0;
+  return write((const uint8_t*)buf, (size_t)len < sizeof(buf) ? len : sizeof(buf) - 1);
+}
+
+size_t Preferences::getString(const char* key, char* buf, size_t len) {
+  if (!isKey(key) || len == 0) return 0;
+  size_t n = values[key].copy(buf, len - 1);
+  buf[n] = '\0';
+  return n;
+}
+
+struct FakeNetwork {
+  const char* ssid;
+  uint8_t bssid[6];
+  int32_t rssi;
+  int32_t channel;
+  wifi_auth_mode_t auth;
+};
+
+static FakeNetwork fakeNetworks[] = {
+  { "HomeNet", { 0x02, 0x11, 0x22, 0x33, 0x44, 0x01 }, -42, 6, WIFI_AUTH_WPA2_PSK },
+  { "Cafe Guest Network 5G", { 0x02, 0x11, 0x22, 0x33, 0x44, 0x02 }, -67, 11, WIFI_AUTH_OPEN },
+  { "Lab", { 0x02, 0x11, 0x22, 0x33, 0x44, 0x03 }, -80, 1, WIFI_AUTH_WPA_WPA2_PSK },
+};
+static const int FAKE_COUNT = sizeof(fakeNetworks) / sizeof(fakeNetworks[0]);
+
+int16_t WiFiClass::scanNetworks(bool, bool) {
+  scanning = true;
+  return WIFI_SCAN_RUNNING;
+}
+
+int16_t WiFiClass::scanComplete() {
+  return scanning ? FAKE_COUNT : WIFI_SCAN_FAILED;
+}
+
+String WiFiClass::SSID(uint8_t i) { return fakeNetworks[i].ssid; }
+int32_t WiFiClass::RSSI(uint8_t i) { return fakeNetworks[i].rssi; }
+int32_t WiFiClass::channel(uint8_t i) { return fakeNetworks[i].channel; }
+uint8_t* WiFiClass::BSSID(uint8_t i) { return fakeNetworks[i].bssid; }
+wifi_auth_mode_t WiFiClass::encryptionType(uint8_t i) { return fakeNetworks[i].auth; }
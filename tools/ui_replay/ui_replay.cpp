@@ -0,0 +1,220 @@
+// Host-side runner for recorded UI traces.
+//
+// Links the real transition table, screens and mode entry code from src/
+// against the stubs in host/, replays each trace and checks the LCD text
+// after every event. It also reports dispatch latency, so UI changes can
+// be regression-tested and benchmarked without hardware.
+//
+// Trace lines use the format the device `replay` command prints:
+//
+//   B MAIN_MENU -> SCAN_MODE 41us |Scanning...     |                |
+//
+// The first character is the event: U D L R B, H (back to the main menu)
+// or T (one loop pass, which finishes a pending scan; the device replay
+// ignores it). The last two |...| fields, if present, are the expected
+// screen. Lines the device marked "skipped" are not run. Lines starting
+// with # are comments.
+//
+// Like the device, the runner skips opening an attack mode, so a trace
+// replays the same way on both. A trace whose first line is "# host-only"
+// opens attack modes (the servers are stubbed here); the device cannot
+// replay those.
+//
+// Build: make -C tools ui_replay
+// Usage: ui_replay [-l max_us] trace...   check traces
+//        ui_replay [-a] -e EVENTS         print a trace for an event string;
+//                                         -a opens attack modes (host-only)
+
+#include "../../src/core/globals.h"
+#include "../../src/input/input_handler.h"
+#include "../../src/input/input_trace.h"
+#include "../../src/output/lcd_handler.h"
+#include "../../src/modules/wifi_scanner.h"
+#include "../../src/modules/survey_history.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Modules the UI calls into that need real hardware
+void setupMitmServer() {}
+void setupApServer() {}
+void statusServerStop() {}
+uint32_t surveyNow() { return 0; }
+void surveyRecordScan(int) {}
+void surveyCancelScan() {}
+bool surveyStats(const uint8_t*, uint32_t, uint32_t, SurveyStats&) { return false; }
+
+struct StepResult {
+  AppState from;
+  uint32_t latencyUs;
+  bool skipped;
+};
+
+static bool attackModes = false;
+
+// Fresh boot: main menu, nothing scanned or selected
+static void resetUi() {
+  currentState = MAIN_MENU;
+  menuIndex = 0;
+  attackMenuIndex = 0;
+  selectedNetwork = -1;
+  networkCount = 0;
+  scrollPos = 0;
+  infoPage = 0;
+  diagPage = 0;
+  logIndex = 0;
+  textOffset = 0;
+  showMainMenu();
+}
+
+// Latency is wall time of the UI code; the stub delay() only moves millis()
+static bool runEvent(char c, StepResult& result) {
+  result.from = currentState;
+  result.latencyUs = 0;
+  result.skipped = !attackModes && currentState == ATTACK_MENU && c == 'R';
+  if (result.skipped) return true;
+  auto start = std::chrono::steady_clock::now();
+  if (c == 'H') {
+    returnToMainMenu();
+  } else if (c == 'T') {
+    if (currentState == SCAN_MODE) updateScanMode();
+  } else {
+    const char letters[] = "UDLRB";
+    const char* p = strchr(letters, c);
+    if (!p || !*p) return false;
+    dispatchEvent((UiEvent)(p - letters));
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  result.latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  return true;
+}
+
+static void printStep(char c, const StepResult& result) {
+  if (result.skipped) {
+    // Same wording as the device
+    printf("%c ATTACK_MENU skipped, attack modes do not run in replay\n", c);
+    return;
+  }
+  printf("%c %s -> %s %luus |%s|%s|\n", c, stateName(result.from), stateName(currentState),
+         (unsigned long)result.latencyUs, lcd.line(0), lcd.line(1));
+}
+
+// Expected screen from the last two |...| fields of a line
+static bool expectedScreen(const std::string& line, std::string& top, std::string& bottom) {
+  size_t end = line.rfind('|');
+  if (end == std::string::npos || end == 0) return false;
+  size_t mid = line.rfind('|', end - 1);
+  if (mid == std::string::npos || mid == 0) return false;
+  size_t begin = line.rfind('|', mid - 1);
+  if (begin == std::string::npos) return false;
+  top = line.substr(begin + 1, mid - begin - 1);
+  bottom = line.substr(mid + 1, end - mid - 1);
+  return true;
+}
+
+static bool checkTrace(const char* path, unsigned long maxUs) {
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "%s: cannot open\n", path);
+    return false;
+  }
+
+  resetUi();
+  attackModes = false;
+  bool ok = true;
+  int lineNo = 0;
+  int events = 0;
+  uint64_t totalUs = 0;
+  uint32_t worstUs = 0;
+  char buf[256];
+
+  while (fgets(buf, sizeof(buf), f)) {
+    lineNo++;
+    std::string line(buf);
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+    if (lineNo == 1 && line == "# host-only") attackModes = true;
+    if (line.empty() || line[0] == '#' || line.find(" skipped") != std::string::npos) continue;
+
+    StepResult result;
+    if (!runEvent(line[0], result)) {
+      fprintf(stderr, "%s:%d: unknown event '%c'\n", path, lineNo, line[0]);
+      ok = false;
+      continue;
+    }
+    if (result.skipped) {
+      fprintf(stderr, "%s:%d: opens an attack mode; mark the trace # host-only\n",
+              path, lineNo);
+      ok = false;
+      continue;
+    }
+    events++;
+    totalUs += result.latencyUs;
+    if (result.latencyUs > worstUs) worstUs = result.latencyUs;
+
+    std::string top, bottom;
+    if (expectedScreen(line, top, bottom) && (top != lcd.line(0) || bottom != lcd.line(1))) {
+      fprintf(stderr, "%s:%d: after %c in %s\n  expected |%s|%s|\n  got      |%s|%s|\n",
+              path, lineNo, line[0], stateName(result.from), top.c_str(), bottom.c_str(),
+              lcd.line(0), lcd.line(1));
+      ok = false;
+    }
+  }
+  fclose(f);
+
+  unsigned long meanUs = events ? totalUs / events : 0;
+  if (maxUs && worstUs > maxUs) {
+    fprintf(stderr, "%s: slowest event took %luus, limit %luus\n", path,
+            (unsigned long)worstUs, maxUs);
+    ok = false;
+  }
+  printf("%s: %d events, mean %luus, max %luus, %s\n", path, events, meanUs,
+         (unsigned long)worstUs, ok ? "ok" : "FAILED");
+  return ok;
+}
+
+static void usage() {
+  fprintf(stderr,
+          "usage: ui_replay [-l max_us] trace...\n"
+          "       ui_replay [-a] -e EVENTS\n"
+          "  -l  fail when any event takes longer than max_us\n"
+          "  -e  replay an event string (UDLRB, H, T) and print it as a trace\n"
+          "  -a  open attack modes like the joystick does (host-only traces)\n");
+}
+
+int main(int argc, char** argv) {
+  lcd.begin(LCD_COLS, LCD_ROWS);
+  unsigned long maxUs = 0;
+  std::vector<const char*> traces;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-a") == 0) {
+      attackModes = true;
+    } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+      resetUi();
+      if (attackModes) printf("# host-only\n");
+      for (const char* c = argv[++i]; *c; c++) {
+        StepResult result;
+        if (runEvent(*c, result)) printStep(*c, result);
+      }
+      return 0;
+    } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+      maxUs = strtoul(argv[++i], nullptr, 10);
+    } else if (argv[i][0] == '-') {
+      usage();
+      return 2;
+    } else {
+      traces.push_back(argv[i]);
+    }
+  }
+  if (traces.empty()) {
+    usage();
+    return 2;
+  }
+
+  bool ok = true;
+  for (const char* path : traces) {
+    if (!checkTrace(path, maxUs)) ok = false;
+  }
+  return ok ? 0 : 1;
+}